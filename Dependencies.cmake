@@ -34,6 +34,29 @@ function(cpp_sandbox_setup_dependencies)
     endif()
   endif()
 
+  if(CPP_SANDBOX_BUILD_BENCHMARKS)
+    if(NOT TARGET benchmark::benchmark_main)
+      if(CPP_SANDBOX_USE_CPM)
+        cpmaddpackage(
+          NAME
+          benchmark
+          VERSION
+          1.9.1
+          GITHUB_REPOSITORY
+          "google/benchmark"
+          OPTIONS
+          "BENCHMARK_ENABLE_TESTING OFF"
+          "BENCHMARK_ENABLE_INSTALL OFF")
+      else()
+        find_package(benchmark REQUIRED)
+      endif()
+    endif()
+  endif()
+
+  if(NOT TARGET Threads::Threads)
+    find_package(Threads REQUIRED)
+  endif()
+
   if(NOT WIN32)
     if(NOT TARGET Iconv::Iconv)
       find_package(Iconv REQUIRED)
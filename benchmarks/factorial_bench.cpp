@@ -0,0 +1,23 @@
+#include <cpp_sandbox/sample_library0.hpp>
+#include <cpp_sandbox/sample_library1.hpp>
+
+#include <benchmark/benchmark.h>
+
+static void BM_sample_library0_factorial(benchmark::State& state) {
+    int input = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(input);
+        benchmark::DoNotOptimize(sample_library0::factorial(input));
+    }
+}
+BENCHMARK(BM_sample_library0_factorial)->Arg(5)->Arg(12);
+
+// sample_library1::factorial 经过一次跨库调用转发到 sample_library0
+static void BM_sample_library1_factorial(benchmark::State& state) {
+    int input = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(input);
+        benchmark::DoNotOptimize(sample_library1::factorial(input));
+    }
+}
+BENCHMARK(BM_sample_library1_factorial)->Arg(5)->Arg(12);
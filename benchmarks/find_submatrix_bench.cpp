@@ -0,0 +1,327 @@
+#include <cpp_sandbox/submatrix_search.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace submatrix_search;
+
+namespace {
+
+// 生成 size x size 的随机二值矩阵，density 为 1 的比例，种子固定以保证结果可复现
+Grid<int> make_grid(int size, double density) {
+    std::mt19937 engine(20240601u);
+    std::bernoulli_distribution one(density);
+    Grid<int> grid(static_cast<size_t>(size), static_cast<size_t>(size));
+    for (size_t i = 0; i < grid.rows(); ++i) {
+        for (int& cell : grid.row(i)) {
+            cell = one(engine) ? 1 : 0;
+        }
+    }
+    return grid;
+}
+
+// 参数：矩阵边长、窗口边长、1 的比例（百分比）
+void grid_args(benchmark::internal::Benchmark* bench) {
+    for (int64_t size : {256, 1024, 2048}) {
+        for (int64_t window : {3, 8}) {
+            for (int64_t density : {90, 99}) {
+                bench->Args({size, window, density});
+            }
+        }
+    }
+    bench->ArgNames({"size", "window", "density"});
+    bench->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+template<typename Acc>
+static void BM_buildPrefixSum(benchmark::State& state) {
+    const auto grid = make_grid(static_cast<int>(state.range(0)), 0.9);
+    Grid<Acc> sum;
+    for (auto _ : state) {
+        buildPrefixSum(grid, sum);
+        benchmark::DoNotOptimize(sum.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0) * state.range(0)));
+}
+BENCHMARK_TEMPLATE(BM_buildPrefixSum, uint32_t)->Arg(256)->Arg(1024)->Arg(2048)->Arg(8192)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_buildPrefixSum, uint64_t)->Arg(256)->Arg(1024)->Arg(2048)->Arg(8192)->Unit(benchmark::kMillisecond);
+
+template<bool CheckOverlap>
+static void BM_findSubmatrices(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    const int window = static_cast<int>(state.range(1));
+    const auto grid = make_grid(size, static_cast<double>(state.range(2)) / 100);
+    Grid<uint32_t> sum;
+    size_t found = 0;
+    for (auto _ : state) {
+        auto rects = findSubmatrices(grid, window, window, sum, CheckOverlap);
+        found = rects.size();
+        benchmark::DoNotOptimize(rects.data());
+    }
+    state.counters["windows"] = static_cast<double>(found);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * size * size);
+}
+BENCHMARK_TEMPLATE(BM_findSubmatrices, false)->Apply(grid_args);
+BENCHMARK_TEMPLATE(BM_findSubmatrices, true)->Apply(grid_args);
+
+// 同一网格依次查找 1x1 到 16x16 的窗口：每次重建前缀和与构建一次后复用
+static void BM_windowSizes_rebuild(benchmark::State& state) {
+    const auto grid = make_grid(static_cast<int>(state.range(0)), 0.99);
+    for (auto _ : state) {
+        for (int window = 1; window <= 16; ++window) {
+            auto rects = findSubmatrices(grid, window, window);
+            benchmark::DoNotOptimize(rects.data());
+        }
+    }
+}
+BENCHMARK(BM_windowSizes_rebuild)->Arg(1024)->Arg(2048)->Unit(benchmark::kMillisecond);
+
+static void BM_windowSizes_query(benchmark::State& state) {
+    const auto grid = make_grid(static_cast<int>(state.range(0)), 0.99);
+    for (auto _ : state) {
+        const SubmatrixQuery query(grid);
+        for (int window = 1; window <= 16; ++window) {
+            auto rects = query.find(window, window);
+            benchmark::DoNotOptimize(rects.data());
+        }
+    }
+}
+BENCHMARK(BM_windowSizes_query)->Arg(1024)->Arg(2048)->Unit(benchmark::kMillisecond);
+
+static void BM_windowSizes_index(benchmark::State& state) {
+    const auto grid = make_grid(static_cast<int>(state.range(0)), 0.99);
+    for (auto _ : state) {
+        const WindowSizeIndex index(grid);
+        for (int window = 1; window <= 16; ++window) {
+            auto rects = index.find(window, window);
+            benchmark::DoNotOptimize(rects.data());
+        }
+    }
+}
+BENCHMARK(BM_windowSizes_index)->Arg(1024)->Arg(2048)->Unit(benchmark::kMillisecond);
+
+// 一次求出 1..64 x 1..64 所有窗口大小的左上角个数
+static void BM_countAllSizes(benchmark::State& state) {
+    const auto grid = make_grid(static_cast<int>(state.range(0)), 0.99);
+    for (auto _ : state) {
+        const WindowSizeIndex index(grid);
+        auto counts = index.countAllSizes(64, 64);
+        benchmark::DoNotOptimize(counts.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0) * state.range(0)));
+}
+BENCHMARK(BM_countAllSizes)->Arg(1024)->Arg(2048)->Unit(benchmark::kMillisecond);
+
+// 每批修改 16 个单元后得到当前全部 8x8 窗口：整表重算与增量更新
+static void BM_cellUpdates_rescan(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    auto grid = make_grid(size, 0.99);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> cell(0, size - 1);
+    for (auto _ : state) {
+        for (int k = 0; k < 16; ++k) {
+            grid(static_cast<size_t>(cell(rng)), static_cast<size_t>(cell(rng))) ^= 1;
+        }
+        auto rects = findSubmatrices(grid, 8, 8);
+        benchmark::DoNotOptimize(rects.data());
+    }
+}
+BENCHMARK(BM_cellUpdates_rescan)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+static void BM_cellUpdates_tracker(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    auto grid = make_grid(size, 0.99);
+    WindowTracker tracker(grid, 8, 8);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> cell(0, size - 1);
+    std::vector<CellChange> changes(16);
+    for (auto _ : state) {
+        for (CellChange& change : changes) {
+            change.row = cell(rng);
+            change.col = cell(rng);
+            change.value = tracker.grid().get(change.row, change.col) ^ 1;
+        }
+        tracker.update(changes);
+        benchmark::DoNotOptimize(&tracker.validPositions());
+    }
+}
+BENCHMARK(BM_cellUpdates_tracker)->Arg(1024)->Arg(4096)->Unit(benchmark::kMicrosecond);
+
+// 逐条带读入并输出 8x8 窗口，只保存每列的连续高度；与整幅前缀和对照见 BM_findSubmatrices
+static void BM_streamingSearch(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    const auto grid = make_grid(size, 0.99);
+    size_t found = 0;
+    for (auto _ : state) {
+        found = 0;
+        StreamingSubmatrixSearch search(grid.cols(), 8, 8, [&](int, const std::vector<int>& cols) { found += cols.size(); });
+        for (size_t row = 0; row < grid.rows(); row += 256) {
+            search.pushRows(grid.row_data(row), std::min<size_t>(256, grid.rows() - row), grid.stride());
+        }
+    }
+    state.counters["windows"] = static_cast<double>(found);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * size * size);
+}
+BENCHMARK(BM_streamingSearch)->Arg(2048)->Arg(8192)->Unit(benchmark::kMillisecond);
+
+static void BM_findSubmatrices_whole(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    const auto grid = make_grid(size, 0.99);
+    for (auto _ : state) {
+        auto rects = findSubmatrices(grid, 8, 8);
+        benchmark::DoNotOptimize(rects.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * size * size);
+}
+BENCHMARK(BM_findSubmatrices_whole)->Arg(2048)->Arg(8192)->Unit(benchmark::kMillisecond);
+
+// 多线程版本，参数为矩阵边长和线程数（0 为硬件并发数）
+static void BM_buildPrefixSumParallel(benchmark::State& state) {
+    const auto grid = make_grid(static_cast<int>(state.range(0)), 0.9);
+    Grid<uint32_t> sum;
+    for (auto _ : state) {
+        buildPrefixSumParallel(grid, sum, static_cast<unsigned>(state.range(1)));
+        benchmark::DoNotOptimize(sum.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0) * state.range(0)));
+}
+BENCHMARK(BM_buildPrefixSumParallel)
+    ->ArgsProduct({{2048, 8192}, {1, 0}})
+    ->ArgNames({"size", "threads"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_findSubmatricesParallel(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    const auto grid = make_grid(size, 0.9);
+    for (auto _ : state) {
+        auto rects = findSubmatricesParallel(grid, 3, 3, false, static_cast<unsigned>(state.range(1)));
+        benchmark::DoNotOptimize(rects.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * size * size);
+}
+BENCHMARK(BM_findSubmatricesParallel)
+    ->ArgsProduct({{2048, 8192}, {1, 0}})
+    ->ArgNames({"size", "threads"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// 按位压缩掩膜上的查找，不计压缩时间
+template<bool CheckOverlap>
+static void BM_findSubmatrices_bitmask(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    const int window = static_cast<int>(state.range(1));
+    const BitMask mask = BitMask::from_grid(make_grid(size, static_cast<double>(state.range(2)) / 100));
+    size_t found = 0;
+    for (auto _ : state) {
+        auto rects = findSubmatrices(mask, window, window, CheckOverlap);
+        found = rects.size();
+        benchmark::DoNotOptimize(rects.data());
+    }
+    state.counters["windows"] = static_cast<double>(found);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * size * size);
+}
+BENCHMARK_TEMPLATE(BM_findSubmatrices_bitmask, false)->Apply(grid_args);
+BENCHMARK_TEMPLATE(BM_findSubmatrices_bitmask, true)->Apply(grid_args);
+
+static void BM_BitMask_from_grid(benchmark::State& state) {
+    const auto grid = make_grid(static_cast<int>(state.range(0)), 0.9);
+    for (auto _ : state) {
+        BitMask mask = BitMask::from_grid(grid);
+        benchmark::DoNotOptimize(mask.row_data(0));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0) * state.range(0)));
+}
+BENCHMARK(BM_BitMask_from_grid)->Arg(256)->Arg(1024)->Arg(2048)->Unit(benchmark::kMillisecond);
+
+// 1 亿像素掩膜上的全图窗口扫描，直接生成压缩数据（约 87.5% 为 1）
+static void BM_allOnesWindows_100mp(benchmark::State& state) {
+    const size_t size = 10000;
+    BitMask mask(size, size);
+    std::mt19937_64 engine(20240601u);
+    for (size_t i = 0; i < size; ++i) {
+        uint64_t* words = mask.row_data(i);
+        for (size_t w = 0; w < mask.words_per_row(); ++w) {
+            words[w] = engine() | engine() | engine();
+        }
+    }
+    mask = BitMask::from_words(mask.row_data(0), size, size, mask.row_data(1) - mask.row_data(0));
+    const int window = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        BitMask windows = allOnesWindows(mask, window, window);
+        benchmark::DoNotOptimize(windows.row_data(0));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size * size));
+}
+BENCHMARK(BM_allOnesWindows_100mp)->Arg(3)->Arg(8)->Unit(benchmark::kMillisecond);
+
+// 大窗口的不重叠选取：几乎全为 1 的网格（每 2 万个单元约有一个 0），候选窗口极多且相互重叠
+static void BM_nonOverlapping_large_window(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    const int window = static_cast<int>(state.range(1));
+    const auto grid = make_grid(size, 0.99995);
+    size_t found = 0;
+    for (auto _ : state) {
+        auto rects = findSubmatrices(grid, window, window, true);
+        found = rects.size();
+        benchmark::DoNotOptimize(rects.data());
+    }
+    state.counters["windows"] = static_cast<double>(found);
+}
+BENCHMARK(BM_nonOverlapping_large_window)
+    ->ArgsProduct({{1024, 2048}, {16, 64}})
+    ->ArgNames({"size", "window"})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_clusterSubmatrices(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    const int window = static_cast<int>(state.range(1));
+    const auto grid = make_grid(size, static_cast<double>(state.range(2)) / 100);
+    const auto rects = findSubmatrices(grid, window, window);
+    size_t clusters = 0;
+    for (auto _ : state) {
+        auto result = clusterSubmatrices(rects, window, window);
+        clusters = result.size();
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.counters["windows"] = static_cast<double>(rects.size());
+    state.counters["clusters"] = static_cast<double>(clusters);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * rects.size()));
+}
+BENCHMARK(BM_clusterSubmatrices)->Apply(grid_args);
+
+// 多线程聚类，参数为矩阵边长和线程数（0 为硬件并发数）
+static void BM_clusterSubmatricesParallel(benchmark::State& state) {
+    const auto grid = make_grid(static_cast<int>(state.range(0)), 0.99);
+    const auto rects = findSubmatrices(grid, 3, 3);
+    for (auto _ : state) {
+        auto result = clusterSubmatricesParallel(rects, 3, 3, static_cast<unsigned>(state.range(1)));
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * rects.size()));
+}
+BENCHMARK(BM_clusterSubmatricesParallel)
+    ->ArgsProduct({{2048, 4096}, {1, 0}})
+    ->ArgNames({"size", "threads"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_getNonOverlappingInClusters(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    const int window = static_cast<int>(state.range(1));
+    const auto grid = make_grid(size, static_cast<double>(state.range(2)) / 100);
+    const auto clusters = clusterSubmatrices(findSubmatrices(grid, window, window), window, window);
+    for (auto _ : state) {
+        auto result = getNonOverlappingInClusters(clusters, window, window);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.counters["clusters"] = static_cast<double>(clusters.size());
+}
+BENCHMARK(BM_getNonOverlappingInClusters)->Apply(grid_args);
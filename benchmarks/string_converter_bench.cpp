@@ -0,0 +1,273 @@
+#include <cpp_sandbox/ConversionCache.hpp>
+#include <cpp_sandbox/StreamingConverter.hpp>
+#include <cpp_sandbox/StringConverter.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <iconv.h>
+#endif
+
+using Encoding = StringConverter::Encoding;
+
+namespace {
+
+// 输入的字符组成：纯 ASCII、纯中文、中英文混合
+enum class Mix { ASCII, CJK, Mixed };
+
+const char* mix_name(Mix mix) {
+    switch (mix) {
+    case Mix::ASCII:
+        return "ascii";
+    case Mix::CJK:
+        return "cjk";
+    default:
+        return "mixed";
+    }
+}
+
+// 构造指定字符数的宽字符测试文本
+std::wstring make_text(size_t chars, Mix mix) {
+    const wchar_t* pattern = L"GIS-01 layer ";
+    if (mix == Mix::CJK) {
+        pattern = L"你好世界地图图层";
+    } else if (mix == Mix::Mixed) {
+        pattern = L"你好世界 GIS-01 ";
+    }
+    std::wstring result;
+    while (result.size() < chars) {
+        result += pattern;
+    }
+    result.resize(chars);
+    return result;
+}
+
+// 将测试文本编码为 E 编码的输入
+template<Encoding E>
+StringConverter::string_type<E> encode(const std::wstring& text) {
+    return StringConverter::convert<Encoding::Wide, E>(text);
+}
+
+// 构造指定字节数的 GB2312 测试输入（中英文混合）
+std::string make_gb2312_input(size_t bytes) {
+    // "你好世界" 的 GB2312 编码 + ASCII
+    const std::string pattern = "\xC4\xE3\xBA\xC3\xCA\xC0\xBD\xE7 GIS-01 ";
+    std::string result;
+    while (result.size() + pattern.size() <= bytes) {
+        result += pattern;
+    }
+    result.append(bytes - result.size(), 'a');
+    return result;
+}
+
+// 按字符数和字符组成生成参数组合
+void conversion_args(benchmark::internal::Benchmark* bench) {
+    for (int64_t chars : {16, 256, 4096, 64 * 1024, 1024 * 1024}) {
+        for (Mix mix : {Mix::ASCII, Mix::CJK, Mix::Mixed}) {
+            bench->Args({chars, static_cast<int64_t>(mix)});
+        }
+    }
+    bench->ArgNames({"chars", "mix"});
+}
+
+}  // namespace
+
+// 单次转换，输出缓冲区在迭代间复用；吞吐量按输入字节计算
+template<Encoding From, Encoding To>
+static void BM_convert(benchmark::State& state) {
+    const Mix mix = static_cast<Mix>(state.range(1));
+    state.SetLabel(mix_name(mix));
+
+    StringConverter::string_type<From> input;
+    try {
+        input = encode<From>(make_text(static_cast<size_t>(state.range(0)), mix));
+    } catch (const std::runtime_error&) {
+        // 当前 ANSI 编码无法表示中文时跳过
+        state.SkipWithError("input is not representable in the source encoding");
+        return;
+    }
+
+    StringConverter::string_type<To> output;
+    for (auto _ : state) {
+        StringConverter::convert<From, To>(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size() * sizeof(input[0])));
+}
+
+BENCHMARK_TEMPLATE(BM_convert, Encoding::UTF8, Encoding::Wide)->Apply(conversion_args);
+BENCHMARK_TEMPLATE(BM_convert, Encoding::Wide, Encoding::UTF8)->Apply(conversion_args);
+BENCHMARK_TEMPLATE(BM_convert, Encoding::ANSI, Encoding::Wide)->Apply(conversion_args);
+BENCHMARK_TEMPLATE(BM_convert, Encoding::Wide, Encoding::ANSI)->Apply(conversion_args);
+BENCHMARK_TEMPLATE(BM_convert, Encoding::UTF8, Encoding::ANSI)->Apply(conversion_args);
+BENCHMARK_TEMPLATE(BM_convert, Encoding::ANSI, Encoding::UTF8)->Apply(conversion_args);
+BENCHMARK_TEMPLATE(BM_convert, Encoding::GB2312, Encoding::Wide)->Apply(conversion_args);
+BENCHMARK_TEMPLATE(BM_convert, Encoding::Wide, Encoding::GB2312)->Apply(conversion_args);
+BENCHMARK_TEMPLATE(BM_convert, Encoding::GB2312, Encoding::UTF8)->Apply(conversion_args);
+BENCHMARK_TEMPLATE(BM_convert, Encoding::UTF8, Encoding::GB2312)->Apply(conversion_args);
+BENCHMARK_TEMPLATE(BM_convert, Encoding::GB2312, Encoding::ANSI)->Apply(conversion_args);
+BENCHMARK_TEMPLATE(BM_convert, Encoding::ANSI, Encoding::GB2312)->Apply(conversion_args);
+
+// 基准：同样大小的内存复制
+static void BM_memcpy_baseline(benchmark::State& state) {
+    const std::string input(static_cast<size_t>(state.range(0)), 'a');
+    std::string output;
+    for (auto _ : state) {
+        output.assign(input);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_memcpy_baseline)->Arg(16)->Arg(256)->Arg(4096)->Arg(64 * 1024)->Arg(1024 * 1024);
+
+#ifndef _WIN32
+// 旧实现：每次调用都打开并关闭 iconv 描述符
+static void BM_gb2312_to_utf8_uncached_iconv(benchmark::State& state) {
+    const std::string input = make_gb2312_input(static_cast<size_t>(state.range(0)));
+    std::vector<char> output(input.size() * 4);
+    for (auto _ : state) {
+        iconv_t cd = iconv_open("UTF-8", "GB2312");
+        if (cd == (iconv_t)-1) {
+            state.SkipWithError("iconv_open failed");
+            break;
+        }
+        char* in_buf = const_cast<char*>(input.data());
+        size_t in_left = input.size();
+        char* out_buf = output.data();
+        size_t out_left = output.size();
+        iconv(cd, &in_buf, &in_left, &out_buf, &out_left);
+        iconv_close(cd);
+        benchmark::DoNotOptimize(out_buf);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_gb2312_to_utf8_uncached_iconv)->Arg(16)->Arg(256)->Arg(64 * 1024);
+
+// 以 4 KiB 为块流式转换，输出只经过固定大小的缓冲区
+static void BM_gb2312_to_utf8_streaming(benchmark::State& state) {
+    const std::string input = make_gb2312_input(static_cast<size_t>(state.range(0)));
+    StreamingConverter streaming = StreamingConverter::gb2312_to_utf8(4096);
+    size_t produced = 0;
+    const StreamingConverter::Sink sink = [&](std::string_view data) { produced += data.size(); };
+    for (auto _ : state) {
+        std::string_view remaining(input);
+        while (!remaining.empty()) {
+            const size_t chunk = std::min<size_t>(remaining.size(), 4096);
+            streaming.write(remaining.substr(0, chunk), sink);
+            remaining.remove_prefix(chunk);
+        }
+        streaming.finish(sink);
+    }
+    benchmark::DoNotOptimize(produced);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_gb2312_to_utf8_streaming)->Arg(256)->Arg(64 * 1024)->Arg(1024 * 1024);
+#endif
+
+// 一列短字符串（如图层属性值）
+static std::vector<std::string> make_column() {
+    std::vector<std::string> column;
+    for (size_t i = 0; i < 10000; ++i) {
+        column.push_back(make_gb2312_input(8 + i % 24));
+    }
+    return column;
+}
+
+static void BM_column_per_element(benchmark::State& state) {
+    const std::vector<std::string> column = make_column();
+    for (auto _ : state) {
+        std::vector<std::string> converted;
+        converted.reserve(column.size());
+        for (const std::string& value : column) {
+            converted.push_back(StringConverter::gb2312_to_utf8(value));
+        }
+        benchmark::DoNotOptimize(converted.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * column.size()));
+}
+BENCHMARK(BM_column_per_element);
+
+static void BM_column_batch(benchmark::State& state) {
+    const std::vector<std::string> column = make_column();
+    for (auto _ : state) {
+        StringBatch converted = StringConverter::batch_gb2312_to_utf8(column);
+        benchmark::DoNotOptimize(converted.data.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * column.size()));
+}
+BENCHMARK(BM_column_batch);
+
+// 同一批标签反复出现
+static void BM_labels_uncached(benchmark::State& state) {
+    const std::vector<std::string> column = make_column();
+    size_t label = 0;
+    for (auto _ : state) {
+        std::string converted = StringConverter::gb2312_to_utf8(column[label++ % 1000]);
+        benchmark::DoNotOptimize(converted.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_labels_uncached);
+
+static void BM_labels_cached(benchmark::State& state) {
+    const std::vector<std::string> column = make_column();
+    ConversionCache cache;
+    size_t label = 0;
+    for (auto _ : state) {
+        ConversionCache::Result converted = cache.gb2312_to_utf8(column[label++ % 1000]);
+        benchmark::DoNotOptimize(converted->data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_labels_cached);
+
+// 对已经是 UTF-8 的输入试探性地按 GB2312 转换：捕获异常与 try_ 版本
+static void BM_speculative_catch(benchmark::State& state) {
+    const std::string input = StringConverter::gb2312_to_utf8(make_gb2312_input(32)) + "\xff";
+    std::string output;
+    for (auto _ : state) {
+        try {
+            StringConverter::gb2312_to_utf8(input, output);
+        } catch (const std::runtime_error&) {
+            output.clear();
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+BENCHMARK(BM_speculative_catch);
+
+static void BM_speculative_try(benchmark::State& state) {
+    const std::string input = StringConverter::gb2312_to_utf8(make_gb2312_input(32)) + "\xff";
+    std::string output;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(StringConverter::try_gb2312_to_utf8(input, output));
+    }
+}
+BENCHMARK(BM_speculative_try);
+
+// 大输入的多线程转换，参数为线程数，1 即串行
+static void BM_parallel_gb2312_to_utf8(benchmark::State& state) {
+    const std::string input = make_gb2312_input(16 * 1024 * 1024);
+    for (auto _ : state) {
+        std::string output = StringConverter::parallel_gb2312_to_utf8(input, static_cast<unsigned int>(state.range(0)));
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_parallel_gb2312_to_utf8)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_parallel_utf8_to_wstring(benchmark::State& state) {
+    const std::string input = StringConverter::gb2312_to_utf8(make_gb2312_input(16 * 1024 * 1024));
+    for (auto _ : state) {
+        std::wstring output = StringConverter::parallel_utf8_to_wstring(input, static_cast<unsigned int>(state.range(0)));
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_parallel_utf8_to_wstring)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,97 @@
+#ifndef CONVERSION_CACHE_H
+#define CONVERSION_CACHE_H
+
+#include <cpp_sandbox/string_converter_export.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// 转换结果缓存，适用于大量重复的短字符串（如地名、分类标签）。
+// 以（编码对，输入字节）为键，按哈希分片，每个分片独立加锁并按最近最少使用淘汰；
+// 总容量按字节计算，命中时只需一次哈希查找。可在多个线程间共享
+class STRING_CONVERTER_EXPORT ConversionCache {
+public:
+    // 缓存的转换结果，缓存淘汰该项后仍然有效
+    using Result = std::shared_ptr<const std::string>;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t bytes = 0;  // 当前占用的字节数（含每项的固定开销）
+    };
+
+    static constexpr size_t kDefaultCapacity = 64 * 1024 * 1024;
+    static constexpr size_t kDefaultShardCount = 16;
+
+    /**
+     * 创建转换缓存
+     * @param capacity_bytes 总容量（字节），平均分给各分片；超过单个分片容量的结果不缓存
+     * @param shard_count 分片数，0 按 1 处理
+     */
+    explicit ConversionCache(size_t capacity_bytes = kDefaultCapacity, size_t shard_count = kDefaultShardCount);
+    ~ConversionCache();
+
+    ConversionCache(const ConversionCache&) = delete;
+    ConversionCache& operator=(const ConversionCache&) = delete;
+
+    /**
+     * 将 GB2312 编码的字符串转换为 UTF-8，结果与 StringConverter::gb2312_to_utf8 相同
+     * @param gb2312_str GB2312 编码的字符串
+     * @return 转换结果
+     * @throws std::runtime_error 转换失败时抛出异常，失败的输入不会被缓存
+     */
+    Result gb2312_to_utf8(std::string_view gb2312_str);
+
+    /**
+     * 将 UTF-8 编码的字符串转换为 GB2312，结果与 StringConverter::utf8_to_gb2312 相同
+     * @param utf8_str UTF-8 编码的字符串
+     * @return 转换结果
+     * @throws std::runtime_error 转换失败时抛出异常，失败的输入不会被缓存
+     */
+    Result utf8_to_gb2312(std::string_view utf8_str);
+
+    /**
+     * 将本地 ANSI 编码的字符串转换为 UTF-8，结果与 StringConverter::ansi_to_utf8 相同
+     * 缓存项不会随 set_ansi_encoding 失效，修改 ANSI 编码后需调用 clear()
+     * @param ansi_str 本地 ANSI 编码的字符串
+     * @return 转换结果
+     * @throws std::runtime_error 转换失败时抛出异常，失败的输入不会被缓存
+     */
+    Result ansi_to_utf8(std::string_view ansi_str);
+
+    /**
+     * 将 UTF-8 编码的字符串转换为本地 ANSI 编码，结果与 StringConverter::utf8_to_ansi 相同
+     * 缓存项不会随 set_ansi_encoding 失效，修改 ANSI 编码后需调用 clear()
+     * @param utf8_str UTF-8 编码的字符串
+     * @return 转换结果
+     * @throws std::runtime_error 转换失败时抛出异常，失败的输入不会被缓存
+     */
+    Result utf8_to_ansi(std::string_view utf8_str);
+
+    /**
+     * 汇总各分片的命中、未命中、淘汰次数和当前占用
+     */
+    Stats stats() const;
+
+    /**
+     * 清空所有缓存项，计数器保持不变
+     */
+    void clear();
+
+private:
+    enum class Conversion : uint8_t;
+    struct Shard;
+
+    template<typename Func>
+    Result lookup(Conversion conversion, std::string_view input, Func convert);
+
+    std::unique_ptr<Shard[]> shards_;
+    size_t shard_count_;
+    size_t shard_capacity_;
+};
+
+#endif // CONVERSION_CACHE_H
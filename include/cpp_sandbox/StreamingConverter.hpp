@@ -0,0 +1,101 @@
+#ifndef STREAMING_CONVERTER_H
+#define STREAMING_CONVERTER_H
+
+#include <cpp_sandbox/string_converter_export.hpp>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef _WIN32
+
+// 分块流式转码器（基于 iconv，仅在非 Windows 平台提供）
+// 输入可以按任意位置切块，跨块的不完整多字节序列会保留到下一块再转换；
+// 输出先写入固定大小的缓冲区，写满或一块处理完时交给回调，内存占用与输入长度无关
+class STRING_CONVERTER_EXPORT StreamingConverter {
+public:
+    // 输出回调，参数在回调返回后失效
+    using Sink = std::function<void(std::string_view)>;
+
+    static constexpr size_t kDefaultBufferSize = 64 * 1024;
+
+    /**
+     * 创建流式转码器
+     * @param from_encoding 源编码（iconv 编码名）
+     * @param to_encoding 目标编码（iconv 编码名）
+     * @param buffer_size 输出缓冲区大小（字节），过小时按 16 字节处理
+     * @throws std::runtime_error 不支持该编码组合时抛出异常
+     */
+    StreamingConverter(std::string_view from_encoding, std::string_view to_encoding,
+                       size_t buffer_size = kDefaultBufferSize);
+    ~StreamingConverter();
+
+    StreamingConverter(StreamingConverter&& other) noexcept;
+    StreamingConverter& operator=(StreamingConverter&& other) noexcept;
+    StreamingConverter(const StreamingConverter&) = delete;
+    StreamingConverter& operator=(const StreamingConverter&) = delete;
+
+    /**
+     * 创建 GB2312 到 UTF-8 的流式转码器，编码表与 StringConverter 一致（代码页 936）
+     * @param buffer_size 输出缓冲区大小（字节）
+     */
+    static StreamingConverter gb2312_to_utf8(size_t buffer_size = kDefaultBufferSize);
+
+    /**
+     * 创建 UTF-8 到 GB2312 的流式转码器，编码表与 StringConverter 一致（代码页 936）
+     * @param buffer_size 输出缓冲区大小（字节）
+     */
+    static StreamingConverter utf8_to_gb2312(size_t buffer_size = kDefaultBufferSize);
+
+    /**
+     * 转换一块输入，本块产生的输出在返回前全部交给 sink
+     * @param chunk 输入数据，可在多字节序列中间截断
+     * @param sink 输出回调，可能被调用多次
+     * @throws std::runtime_error 遇到非法序列时抛出异常，转码器随即被重置
+     */
+    void write(std::string_view chunk, const Sink& sink);
+
+    /**
+     * 结束当前流：输出移位状态的收尾序列并重置转码器，之后可以开始新的流
+     * @param sink 输出回调
+     * @throws std::runtime_error 输入以不完整的多字节序列结尾时抛出异常
+     */
+    void finish(const Sink& sink);
+
+    /**
+     * 丢弃残留输入和未输出的数据，回到初始状态
+     */
+    void reset();
+
+    /**
+     * 以 buffer_size 大小的块读取 input 直到结束，转换结果写入 output
+     * @param input 输入流
+     * @param output 输出流
+     * @throws std::runtime_error 转换失败或读写出错时抛出异常
+     */
+    void transcode(std::istream& input, std::ostream& output);
+
+    /**
+     * 当前保留的不完整序列字节数
+     */
+    size_t pending_bytes() const { return pending_size_; }
+
+private:
+    bool convert(const char*& input, size_t& input_left, const Sink& sink);
+    void flush(const Sink& sink);
+    [[noreturn]] void fail(int error);
+
+    void* descriptor_;  // iconv_t
+    std::string from_encoding_;
+    std::string to_encoding_;
+    std::vector<char> buffer_;
+    size_t used_ = 0;
+    char pending_[16];
+    size_t pending_size_ = 0;
+};
+
+#endif // _WIN32
+
+#endif // STREAMING_CONVERTER_H
@@ -0,0 +1,53 @@
+#ifndef STRING_BATCH_H
+#define STRING_BATCH_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 字符串序列的只读视图，可由 std::vector<std::string>、std::vector<std::string_view>
+// 或 string_view 数组隐式构造，不复制任何字符串
+class StringSpan {
+public:
+    StringSpan(const std::vector<std::string>& strings)
+        : data_(strings.data()), size_(strings.size()), at_(&element<std::string>) {}
+    StringSpan(const std::vector<std::string_view>& strings)
+        : data_(strings.data()), size_(strings.size()), at_(&element<std::string_view>) {}
+    StringSpan(const std::string_view* strings, size_t size)
+        : data_(strings), size_(size), at_(&element<std::string_view>) {}
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::string_view operator[](size_t index) const { return at_(data_, index); }
+
+private:
+    template<typename T>
+    static std::string_view element(const void* data, size_t index) {
+        return static_cast<const T*>(data)[index];
+    }
+
+    const void* data_;
+    size_t size_;
+    std::string_view (*at_)(const void*, size_t);
+};
+
+// 批量转换结果（Arrow 风格）：所有字符串连续存放在 data 中，
+// 第 i 个字符串为 data[offsets[i], offsets[i + 1])，offsets 比字符串个数多一项
+template<typename CharT>
+struct BasicStringBatch {
+    std::basic_string<CharT> data;
+    std::vector<size_t> offsets{0};
+
+    size_t size() const { return offsets.size() - 1; }
+    bool empty() const { return offsets.size() <= 1; }
+
+    std::basic_string_view<CharT> operator[](size_t index) const {
+        return std::basic_string_view<CharT>(data.data() + offsets[index], offsets[index + 1] - offsets[index]);
+    }
+};
+
+using StringBatch = BasicStringBatch<char>;
+using WStringBatch = BasicStringBatch<wchar_t>;
+
+#endif // STRING_BATCH_H
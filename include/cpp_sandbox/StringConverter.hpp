@@ -1,18 +1,99 @@
 #ifndef STRING_CONVERTER_H
 #define STRING_CONVERTER_H
 
+#include <cpp_sandbox/StringBatch.hpp>
 #include <cpp_sandbox/string_converter_export.hpp>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 
+// 所有转换函数的输入均为 std::string_view / std::wstring_view，
+// 可以直接传入 std::string、字符串字面量或内存映射文件中的片段而无需复制
 class STRING_CONVERTER_EXPORT StringConverter {
 public:
+    // convert / append 模板使用的编码标识；Wide 为平台 wchar_t 编码（Windows 上为 UTF-16，其它平台为 UTF-32）
+    enum class Encoding {
+        UTF8,
+        GB2312,
+        ANSI,
+        Wide,
+    };
+
+    // 编码对应的字符串类型：Wide 使用 std::wstring / std::wstring_view，其余使用 std::string / std::string_view
+    template<Encoding E>
+    using string_type = std::conditional_t<E == Encoding::Wide, std::wstring, std::string>;
+    template<Encoding E>
+    using view_type = std::conditional_t<E == Encoding::Wide, std::wstring_view, std::string_view>;
+
+    /**
+     * 将 From 编码的字符串转换为 To 编码，转换内核在编译期按编码对选定（内置码表、SIMD UTF-8 转码器
+     * 或 iconv），运行时不再按编码名称分派；源编码与目标编码相同时直接复制。下列具名函数均为对应编码对的包装
+     * @param input From 编码的字符串
+     * @return 转换后的 To 编码字符串
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    template<Encoding From, Encoding To>
+    static string_type<To> convert(view_type<From> input) {
+        string_type<To> output;
+        append<From, To>(input, output);
+        return output;
+    }
+
+    /**
+     * 将 From 编码的字符串转换为 To 编码，结果写入 output 并复用其已有容量
+     * @param input From 编码的字符串
+     * @param output 输出缓冲区，原有内容会被清空
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    template<Encoding From, Encoding To>
+    static void convert(view_type<From> input, string_type<To>& output) {
+        output.clear();
+        append<From, To>(input, output);
+    }
+
+    /**
+     * 将 From 编码的字符串转换为 To 编码，结果追加到 output 末尾；
+     * 库中已为全部 16 种编码对显式实例化
+     * @param input From 编码的字符串
+     * @param output 输出缓冲区，转换失败时恢复为调用前的内容
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    template<Encoding From, Encoding To>
+    static void append(view_type<From> input, string_type<To>& output);
+
     /**
      * 将 UTF-8 编码的 std::string 转换为 std::wstring
      * @param utf8_str UTF-8 编码的字符串
      * @return 转换后的宽字符串
      * @throws std::runtime_error 转换失败时抛出异常
      */
-    static std::wstring utf8_to_wstring(const std::string& utf8_str);
+    static std::wstring utf8_to_wstring(std::string_view utf8_str);
+    
+    /**
+     * 将 UTF-8 编码的 std::string 转换为 std::wstring，结果写入 output 并复用其已有容量
+     * @param utf8_str UTF-8 编码的字符串
+     * @param output 输出缓冲区，原有内容会被清空
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void utf8_to_wstring(std::string_view utf8_str, std::wstring& output);
+    
+    /**
+     * 将 UTF-8 编码的 std::string 转换为 std::wstring，结果追加到 output 末尾
+     * @param utf8_str UTF-8 编码的字符串
+     * @param output 输出缓冲区，转换失败时恢复为调用前的内容
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void append_utf8_to_wstring(std::string_view utf8_str, std::wstring& output);
+    
+    /**
+     * 将 UTF-8 编码的 std::string 转换为 std::wstring，大输入在字符边界处分块后多线程转换
+     * @param utf8_str UTF-8 编码的字符串
+     * @param thread_count 线程数，0 表示使用硬件并发数；每块不足 256 KiB 时自动减少分块
+     * @return 转换后的宽字符串，与 utf8_to_wstring 的结果相同
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static std::wstring parallel_utf8_to_wstring(std::string_view utf8_str, unsigned int thread_count = 0);
     
     /**
      * 将 std::wstring 转换为 UTF-8 编码的 std::string
@@ -20,7 +101,23 @@ public:
      * @return 转换后的 UTF-8 编码字符串
      * @throws std::runtime_error 转换失败时抛出异常
      */
-    static std::string wstring_to_utf8(const std::wstring& wide_str);
+    static std::string wstring_to_utf8(std::wstring_view wide_str);
+    
+    /**
+     * 将 std::wstring 转换为 UTF-8 编码的 std::string，结果写入 output 并复用其已有容量
+     * @param wide_str 宽字符串
+     * @param output 输出缓冲区，原有内容会被清空
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void wstring_to_utf8(std::wstring_view wide_str, std::string& output);
+    
+    /**
+     * 将 std::wstring 转换为 UTF-8 编码的 std::string，结果追加到 output 末尾
+     * @param wide_str 宽字符串
+     * @param output 输出缓冲区，转换失败时恢复为调用前的内容
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void append_wstring_to_utf8(std::wstring_view wide_str, std::string& output);
     
     /**
      * 将本地 ANSI 编码的 std::string 转换为 std::wstring
@@ -28,7 +125,23 @@ public:
      * @return 转换后的宽字符串
      * @throws std::runtime_error 转换失败时抛出异常
      */
-    static std::wstring ansi_to_wstring(const std::string& ansi_str);
+    static std::wstring ansi_to_wstring(std::string_view ansi_str);
+    
+    /**
+     * 将本地 ANSI 编码的 std::string 转换为 std::wstring，结果写入 output 并复用其已有容量
+     * @param ansi_str 本地 ANSI 编码的字符串
+     * @param output 输出缓冲区，原有内容会被清空
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void ansi_to_wstring(std::string_view ansi_str, std::wstring& output);
+    
+    /**
+     * 将本地 ANSI 编码的 std::string 转换为 std::wstring，结果追加到 output 末尾
+     * @param ansi_str 本地 ANSI 编码的字符串
+     * @param output 输出缓冲区，转换失败时恢复为调用前的内容
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void append_ansi_to_wstring(std::string_view ansi_str, std::wstring& output);
     
     /**
      * 将 std::wstring 转换为本地 ANSI 编码的 std::string
@@ -36,7 +149,23 @@ public:
      * @return 转换后的本地 ANSI 编码字符串
      * @throws std::runtime_error 转换失败时抛出异常
      */
-    static std::string wstring_to_ansi(const std::wstring& wide_str);
+    static std::string wstring_to_ansi(std::wstring_view wide_str);
+    
+    /**
+     * 将 std::wstring 转换为本地 ANSI 编码的 std::string，结果写入 output 并复用其已有容量
+     * @param wide_str 宽字符串
+     * @param output 输出缓冲区，原有内容会被清空
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void wstring_to_ansi(std::wstring_view wide_str, std::string& output);
+    
+    /**
+     * 将 std::wstring 转换为本地 ANSI 编码的 std::string，结果追加到 output 末尾
+     * @param wide_str 宽字符串
+     * @param output 输出缓冲区，转换失败时恢复为调用前的内容
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void append_wstring_to_ansi(std::wstring_view wide_str, std::string& output);
     
     /**
      * 将 UTF-8 编码的 std::string 直接转换为本地 ANSI 编码的 std::string
@@ -44,7 +173,23 @@ public:
      * @return 转换后的本地 ANSI 编码字符串
      * @throws std::runtime_error 转换失败时抛出异常
      */
-    static std::string utf8_to_ansi(const std::string& utf8_str);
+    static std::string utf8_to_ansi(std::string_view utf8_str);
+    
+    /**
+     * 将 UTF-8 编码的 std::string 直接转换为本地 ANSI 编码的 std::string，结果写入 output 并复用其已有容量
+     * @param utf8_str UTF-8 编码的字符串
+     * @param output 输出缓冲区，原有内容会被清空
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void utf8_to_ansi(std::string_view utf8_str, std::string& output);
+    
+    /**
+     * 将 UTF-8 编码的 std::string 直接转换为本地 ANSI 编码的 std::string，结果追加到 output 末尾
+     * @param utf8_str UTF-8 编码的字符串
+     * @param output 输出缓冲区，转换失败时恢复为调用前的内容
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void append_utf8_to_ansi(std::string_view utf8_str, std::string& output);
     
     /**
      * 将本地 ANSI 编码的 std::string 直接转换为 UTF-8 编码的 std::string
@@ -52,7 +197,23 @@ public:
      * @return 转换后的 UTF-8 编码字符串
      * @throws std::runtime_error 转换失败时抛出异常
      */
-    static std::string ansi_to_utf8(const std::string& ansi_str);
+    static std::string ansi_to_utf8(std::string_view ansi_str);
+    
+    /**
+     * 将本地 ANSI 编码的 std::string 直接转换为 UTF-8 编码的 std::string，结果写入 output 并复用其已有容量
+     * @param ansi_str 本地 ANSI 编码的字符串
+     * @param output 输出缓冲区，原有内容会被清空
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void ansi_to_utf8(std::string_view ansi_str, std::string& output);
+    
+    /**
+     * 将本地 ANSI 编码的 std::string 直接转换为 UTF-8 编码的 std::string，结果追加到 output 末尾
+     * @param ansi_str 本地 ANSI 编码的字符串
+     * @param output 输出缓冲区，转换失败时恢复为调用前的内容
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void append_ansi_to_utf8(std::string_view ansi_str, std::string& output);
     
     /**
      * 将 GB2312 编码的 std::string 转换为 std::wstring
@@ -60,7 +221,23 @@ public:
      * @return 转换后的宽字符串
      * @throws std::runtime_error 转换失败时抛出异常
      */
-    static std::wstring gb2312_to_wstring(const std::string& gb2312_str);
+    static std::wstring gb2312_to_wstring(std::string_view gb2312_str);
+    
+    /**
+     * 将 GB2312 编码的 std::string 转换为 std::wstring，结果写入 output 并复用其已有容量
+     * @param gb2312_str GB2312 编码的字符串
+     * @param output 输出缓冲区，原有内容会被清空
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void gb2312_to_wstring(std::string_view gb2312_str, std::wstring& output);
+    
+    /**
+     * 将 GB2312 编码的 std::string 转换为 std::wstring，结果追加到 output 末尾
+     * @param gb2312_str GB2312 编码的字符串
+     * @param output 输出缓冲区，转换失败时恢复为调用前的内容
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void append_gb2312_to_wstring(std::string_view gb2312_str, std::wstring& output);
     
     /**
      * 将 std::wstring 转换为 GB2312 编码的 std::string
@@ -68,7 +245,23 @@ public:
      * @return 转换后的 GB2312 编码字符串
      * @throws std::runtime_error 转换失败时抛出异常
      */
-    static std::string wstring_to_gb2312(const std::wstring& wide_str);
+    static std::string wstring_to_gb2312(std::wstring_view wide_str);
+    
+    /**
+     * 将 std::wstring 转换为 GB2312 编码的 std::string，结果写入 output 并复用其已有容量
+     * @param wide_str 宽字符串
+     * @param output 输出缓冲区，原有内容会被清空
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void wstring_to_gb2312(std::wstring_view wide_str, std::string& output);
+    
+    /**
+     * 将 std::wstring 转换为 GB2312 编码的 std::string，结果追加到 output 末尾
+     * @param wide_str 宽字符串
+     * @param output 输出缓冲区，转换失败时恢复为调用前的内容
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void append_wstring_to_gb2312(std::wstring_view wide_str, std::string& output);
     
     /**
      * 将 GB2312 编码的 std::string 转换为 UTF-8 编码的 std::string
@@ -76,7 +269,50 @@ public:
      * @return 转换后的 UTF-8 编码字符串
      * @throws std::runtime_error 转换失败时抛出异常
      */
-    static std::string gb2312_to_utf8(const std::string& gb2312_str);
+    static std::string gb2312_to_utf8(std::string_view gb2312_str);
+    
+    /**
+     * 将 GB2312 编码的 std::string 转换为 UTF-8 编码的 std::string，结果写入 output 并复用其已有容量
+     * @param gb2312_str GB2312 编码的字符串
+     * @param output 输出缓冲区，原有内容会被清空
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void gb2312_to_utf8(std::string_view gb2312_str, std::string& output);
+    
+    /**
+     * 将 GB2312 编码的 std::string 转换为 UTF-8 编码的 std::string，结果追加到 output 末尾
+     * @param gb2312_str GB2312 编码的字符串
+     * @param output 输出缓冲区，转换失败时恢复为调用前的内容
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void append_gb2312_to_utf8(std::string_view gb2312_str, std::string& output);
+    
+    /**
+     * 将 GB2312 编码的 std::string 转换为 UTF-8 编码的 std::string，大输入在字符边界处分块后多线程转换
+     * @param gb2312_str GB2312 编码的字符串
+     * @param thread_count 线程数，0 表示使用硬件并发数；每块不足 256 KiB 时自动减少分块
+     * @return 转换后的 UTF-8 编码字符串，与 gb2312_to_utf8 的结果相同
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static std::string parallel_gb2312_to_utf8(std::string_view gb2312_str, unsigned int thread_count = 0);
+    
+    /**
+     * 在 UTF-8 输入中找到不小于 position 的第一个字符边界，边界两侧可以分块独立转换
+     * @param input UTF-8 编码的字符串
+     * @param position 期望的分块位置，超过输入长度时返回 input.size()
+     * @param previous 之前已知的字符边界，UTF-8 不需要，仅为与 gb2312_chunk_boundary 保持同一签名
+     * @return [position, input.size()] 内的字符边界
+     */
+    static size_t utf8_chunk_boundary(std::string_view input, size_t position, size_t previous = 0);
+    
+    /**
+     * 在 GB2312 输入中找到不小于 position 的第一个字符边界，边界两侧可以分块独立转换
+     * @param input GB2312 编码的字符串
+     * @param position 期望的分块位置，超过输入长度时返回 input.size()
+     * @param previous 之前已知的字符边界（不大于 position），向前判断双字节对齐时扫描到此为止
+     * @return [position, input.size()] 内的字符边界
+     */
+    static size_t gb2312_chunk_boundary(std::string_view input, size_t position, size_t previous = 0);
     
     /**
      * 将 UTF-8 编码的 std::string 转换为 GB2312 编码的 std::string
@@ -84,7 +320,23 @@ public:
      * @return 转换后的 GB2312 编码字符串
      * @throws std::runtime_error 转换失败时抛出异常
      */
-    static std::string utf8_to_gb2312(const std::string& utf8_str);
+    static std::string utf8_to_gb2312(std::string_view utf8_str);
+    
+    /**
+     * 将 UTF-8 编码的 std::string 转换为 GB2312 编码的 std::string，结果写入 output 并复用其已有容量
+     * @param utf8_str UTF-8 编码的字符串
+     * @param output 输出缓冲区，原有内容会被清空
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void utf8_to_gb2312(std::string_view utf8_str, std::string& output);
+    
+    /**
+     * 将 UTF-8 编码的 std::string 转换为 GB2312 编码的 std::string，结果追加到 output 末尾
+     * @param utf8_str UTF-8 编码的字符串
+     * @param output 输出缓冲区，转换失败时恢复为调用前的内容
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void append_utf8_to_gb2312(std::string_view utf8_str, std::string& output);
     
     /**
      * 将 GB2312 编码的 std::string 转换为本地 ANSI 编码的 std::string
@@ -92,7 +344,23 @@ public:
      * @return 转换后的本地 ANSI 编码字符串
      * @throws std::runtime_error 转换失败时抛出异常
      */
-    static std::string gb2312_to_ansi(const std::string& gb2312_str);
+    static std::string gb2312_to_ansi(std::string_view gb2312_str);
+    
+    /**
+     * 将 GB2312 编码的 std::string 转换为本地 ANSI 编码的 std::string，结果写入 output 并复用其已有容量
+     * @param gb2312_str GB2312 编码的字符串
+     * @param output 输出缓冲区，原有内容会被清空
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void gb2312_to_ansi(std::string_view gb2312_str, std::string& output);
+    
+    /**
+     * 将 GB2312 编码的 std::string 转换为本地 ANSI 编码的 std::string，结果追加到 output 末尾
+     * @param gb2312_str GB2312 编码的字符串
+     * @param output 输出缓冲区，转换失败时恢复为调用前的内容
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void append_gb2312_to_ansi(std::string_view gb2312_str, std::string& output);
     
     /**
      * 将本地 ANSI 编码的 std::string 转换为 GB2312 编码的 std::string
@@ -100,13 +368,188 @@ public:
      * @return 转换后的 GB2312 编码字符串
      * @throws std::runtime_error 转换失败时抛出异常
      */
-    static std::string ansi_to_gb2312(const std::string& ansi_str);
+    static std::string ansi_to_gb2312(std::string_view ansi_str);
+    
+    /**
+     * 将本地 ANSI 编码的 std::string 转换为 GB2312 编码的 std::string，结果写入 output 并复用其已有容量
+     * @param ansi_str 本地 ANSI 编码的字符串
+     * @param output 输出缓冲区，原有内容会被清空
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void ansi_to_gb2312(std::string_view ansi_str, std::string& output);
+    
+    /**
+     * 将本地 ANSI 编码的 std::string 转换为 GB2312 编码的 std::string，结果追加到 output 末尾
+     * @param ansi_str 本地 ANSI 编码的字符串
+     * @param output 输出缓冲区，转换失败时恢复为调用前的内容
+     * @throws std::runtime_error 转换失败时抛出异常
+     */
+    static void append_ansi_to_gb2312(std::string_view ansi_str, std::string& output);
+    
+    /**
+     * 批量将 UTF-8 编码的字符串转换为 std::wstring，所有结果连续存放在一块内存中
+     * @param utf8_strs UTF-8 编码的字符串序列
+     * @param thread_count 线程数，默认串行；0 表示使用硬件并发数，总输入不足 256 KiB 时始终串行
+     * @return 转换结果，第 i 项对应第 i 个输入
+     * @throws std::runtime_error 任一字符串转换失败时抛出异常，信息中包含其下标
+     */
+    static WStringBatch batch_utf8_to_wstring(StringSpan utf8_strs, unsigned int thread_count = 1);
+    
+    /**
+     * 批量将 GB2312 编码的字符串转换为 std::wstring，所有结果连续存放在一块内存中
+     * @param gb2312_strs GB2312 编码的字符串序列
+     * @param thread_count 线程数，默认串行；0 表示使用硬件并发数，总输入不足 256 KiB 时始终串行
+     * @return 转换结果，第 i 项对应第 i 个输入
+     * @throws std::runtime_error 任一字符串转换失败时抛出异常，信息中包含其下标
+     */
+    static WStringBatch batch_gb2312_to_wstring(StringSpan gb2312_strs, unsigned int thread_count = 1);
+    
+    /**
+     * 批量将 GB2312 编码的字符串转换为 UTF-8 编码的字符串，所有结果连续存放在一块内存中
+     * @param gb2312_strs GB2312 编码的字符串序列
+     * @param thread_count 线程数，默认串行；0 表示使用硬件并发数，总输入不足 256 KiB 时始终串行
+     * @return 转换结果，第 i 项对应第 i 个输入
+     * @throws std::runtime_error 任一字符串转换失败时抛出异常，信息中包含其下标
+     */
+    static StringBatch batch_gb2312_to_utf8(StringSpan gb2312_strs, unsigned int thread_count = 1);
+    
+    /**
+     * 批量将 UTF-8 编码的字符串转换为 GB2312 编码的字符串，所有结果连续存放在一块内存中
+     * @param utf8_strs UTF-8 编码的字符串序列
+     * @param thread_count 线程数，默认串行；0 表示使用硬件并发数，总输入不足 256 KiB 时始终串行
+     * @return 转换结果，第 i 项对应第 i 个输入
+     * @throws std::runtime_error 任一字符串转换失败时抛出异常，信息中包含其下标
+     */
+    static StringBatch batch_utf8_to_gb2312(StringSpan utf8_strs, unsigned int thread_count = 1);
+    
+    /**
+     * 批量将本地 ANSI 编码的字符串转换为 UTF-8 编码的字符串，所有结果连续存放在一块内存中
+     * @param ansi_strs 本地 ANSI 编码的字符串序列
+     * @param thread_count 线程数，默认串行；0 表示使用硬件并发数，总输入不足 256 KiB 时始终串行
+     * @return 转换结果，第 i 项对应第 i 个输入
+     * @throws std::runtime_error 任一字符串转换失败时抛出异常，信息中包含其下标
+     */
+    static StringBatch batch_ansi_to_utf8(StringSpan ansi_strs, unsigned int thread_count = 1);
+    
+    /**
+     * 批量将 UTF-8 编码的字符串转换为本地 ANSI 编码的字符串，所有结果连续存放在一块内存中
+     * @param utf8_strs UTF-8 编码的字符串序列
+     * @param thread_count 线程数，默认串行；0 表示使用硬件并发数，总输入不足 256 KiB 时始终串行
+     * @return 转换结果，第 i 项对应第 i 个输入
+     * @throws std::runtime_error 任一字符串转换失败时抛出异常，信息中包含其下标
+     */
+    static StringBatch batch_utf8_to_ansi(StringSpan utf8_strs, unsigned int thread_count = 1);
+    
+    // 编码检测结果
+    enum class DetectedEncoding {
+        Unknown,  // 既不是合法的 UTF-8，也不是合法的 GB2312/GBK
+        ASCII,    // 纯 ASCII，可按任意兼容 ASCII 的编码处理
+        UTF8,     // 合法的 UTF-8（含非 ASCII 字符）
+        GB2312,   // 合法的 GB2312/GBK（代码页 936），且不是合法的 UTF-8
+    };
+    
+    /**
+     * 判断字符串是否只包含 ASCII 字符（SIMD 加速）
+     * @param str 任意编码的字符串
+     * @return 所有字节都小于 0x80 时返回 true
+     */
+    static bool is_ascii(std::string_view str) noexcept;
+    
+    /**
+     * 判断字符串是否为合法的 UTF-8（SIMD 加速），规则与 utf8_to_wstring 一致
+     * @param str 待检查的字符串
+     * @return 合法时返回 true，过长编码、代理项和末尾不完整的序列均视为不合法
+     */
+    static bool is_valid_utf8(std::string_view str) noexcept;
+    
+    /**
+     * 判断字符串是否为合法的 GB2312/GBK（代码页 936）编码，规则与 gb2312_to_utf8 一致
+     * @param str 待检查的字符串
+     * @return 合法时返回 true
+     */
+    static bool is_valid_gb2312(std::string_view str) noexcept;
+    
+    /**
+     * 推测字符串的编码：纯 ASCII、合法 UTF-8 优先于 GB2312，均不合法时返回 Unknown
+     * 短字符串可能同时是合法的 UTF-8 和 GB2312，此时按 UTF-8 处理
+     * @param str 待检测的字符串
+     * @return 检测结果
+     */
+    static DetectedEncoding detect_encoding(std::string_view str) noexcept;
+    
+    /**
+     * 不抛出异常的 utf8_to_wstring，适用于输入经常不合法、需要据此分支的场景
+     * @param utf8_str UTF-8 编码的字符串
+     * @param output 输出缓冲区，原有内容会被清空；转换失败时为空
+     * @return 成功时为空的错误码；std::errc::illegal_byte_sequence 表示非法序列，
+     *         std::errc::invalid_argument 表示输入末尾的多字节序列不完整
+     */
+    static std::error_code try_utf8_to_wstring(std::string_view utf8_str, std::wstring& output) noexcept;
+    
+    /**
+     * 不抛出异常的 wstring_to_utf8，适用于输入经常不合法、需要据此分支的场景
+     * @param wide_str 宽字符串
+     * @param output 输出缓冲区，原有内容会被清空；转换失败时为空
+     * @return 成功时为空的错误码；std::errc::illegal_byte_sequence 表示非法序列，
+     *         std::errc::invalid_argument 表示输入末尾的多字节序列不完整
+     */
+    static std::error_code try_wstring_to_utf8(std::wstring_view wide_str, std::string& output) noexcept;
+    
+    /**
+     * 不抛出异常的 gb2312_to_wstring，适用于输入经常不合法、需要据此分支的场景
+     * @param gb2312_str GB2312 编码的字符串
+     * @param output 输出缓冲区，原有内容会被清空；转换失败时为空
+     * @return 成功时为空的错误码；std::errc::illegal_byte_sequence 表示非法序列，
+     *         std::errc::invalid_argument 表示输入末尾的多字节序列不完整
+     */
+    static std::error_code try_gb2312_to_wstring(std::string_view gb2312_str, std::wstring& output) noexcept;
+    
+    /**
+     * 不抛出异常的 wstring_to_gb2312，适用于输入经常不合法、需要据此分支的场景
+     * @param wide_str 宽字符串
+     * @param output 输出缓冲区，原有内容会被清空；转换失败时为空
+     * @return 成功时为空的错误码；std::errc::illegal_byte_sequence 表示非法序列，
+     *         std::errc::invalid_argument 表示输入末尾的多字节序列不完整
+     */
+    static std::error_code try_wstring_to_gb2312(std::wstring_view wide_str, std::string& output) noexcept;
+    
+    /**
+     * 不抛出异常的 gb2312_to_utf8，适用于输入经常不合法、需要据此分支的场景
+     * @param gb2312_str GB2312 编码的字符串
+     * @param output 输出缓冲区，原有内容会被清空；转换失败时为空
+     * @return 成功时为空的错误码；std::errc::illegal_byte_sequence 表示非法序列，
+     *         std::errc::invalid_argument 表示输入末尾的多字节序列不完整
+     */
+    static std::error_code try_gb2312_to_utf8(std::string_view gb2312_str, std::string& output) noexcept;
+    
+    /**
+     * 不抛出异常的 utf8_to_gb2312，适用于输入经常不合法、需要据此分支的场景
+     * @param utf8_str UTF-8 编码的字符串
+     * @param output 输出缓冲区，原有内容会被清空；转换失败时为空
+     * @return 成功时为空的错误码；std::errc::illegal_byte_sequence 表示非法序列，
+     *         std::errc::invalid_argument 表示输入末尾的多字节序列不完整
+     */
+    static std::error_code try_utf8_to_gb2312(std::string_view utf8_str, std::string& output) noexcept;
+    
+    /**
+     * 指定 ANSI 转换使用的编码，覆盖从 LANG / LC_CTYPE 检测到的系统编码，可在服务启动时调用
+     * Windows 平台的 ANSI 转换始终使用系统代码页，调用此函数没有效果
+     * @param encoding iconv 编码名称，如 "GBK"；为空时恢复使用检测到的系统编码
+     * @throws std::runtime_error 不支持该编码时抛出异常
+     */
+    static void set_ansi_encoding(std::string_view encoding);
     
     /**
      * 获取当前系统的 ANSI 代码页
      * @return 当前 ANSI 代码页编号，在非 Windows 系统上返回 0
      */
     static unsigned int get_ansi_codepage();
+    
+    /**
+     * 获取 ANSI 转换当前使用的编码名称
+     * @return set_ansi_encoding 设置的编码，未设置时为从 LANG / LC_CTYPE 检测到的编码；Windows 上为 "CP" 加系统代码页
+     */
+    static std::string get_ansi_encoding();
 };
 
 #endif // STRING_CONVERTER_H
\ No newline at end of file
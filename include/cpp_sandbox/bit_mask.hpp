@@ -0,0 +1,86 @@
+#ifndef CPP_SANDBOX_BIT_MASK_HPP
+#define CPP_SANDBOX_BIT_MASK_HPP
+
+#include <cpp_sandbox/grid.hpp>
+#include <cpp_sandbox/submatrix_search_export.hpp>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace submatrix_search {
+
+// 按位压缩的二值矩阵：每个 64 位字存放一行中连续的 64 个单元，
+// 第 c 列位于该行第 c / 64 个字的第 c % 64 位（低位在前）。
+// 每行末尾超出 cols() 的位始终为 0，行起始地址按 64 字节对齐
+class SUBMATRIX_SEARCH_EXPORT BitMask {
+public:
+    static constexpr size_t kBitsPerWord = 64;
+
+    BitMask() = default;
+
+    // 全 0 的 rows x cols 矩阵
+    BitMask(size_t rows, size_t cols);
+
+    // 由稠密矩阵构造，非 0 单元记为 1
+    static BitMask from_grid(const Grid<int>& grid);
+
+    // 由每单元一个字节的数据构造（如栅格掩膜），非 0 单元记为 1；row_stride 为相邻两行的字节距离
+    static BitMask from_bytes(const uint8_t* cells, size_t rows, size_t cols, size_t row_stride);
+
+    // 直接载入已压缩的数据，格式与本类相同；words_per_row 为输入中相邻两行的字数
+    static BitMask from_words(const uint64_t* words, size_t rows, size_t cols, size_t words_per_row);
+
+    size_t rows() const { return words_.rows(); }
+    size_t cols() const { return cols_; }
+    size_t words_per_row() const { return words_.cols(); }
+
+    bool get(size_t row, size_t col) const {
+        return (words_(row, col / kBitsPerWord) >> (col % kBitsPerWord)) & 1u;
+    }
+
+    void set(size_t row, size_t col, bool value = true) {
+        const uint64_t bit = uint64_t(1) << (col % kBitsPerWord);
+        uint64_t& word = words_(row, col / kBitsPerWord);
+        word = value ? (word | bit) : (word & ~bit);
+    }
+
+    uint64_t* row_data(size_t row) { return words_.row_data(row); }
+    const uint64_t* row_data(size_t row) const { return words_.row_data(row); }
+
+    // 值为 1 的单元个数
+    size_t count() const;
+
+    // 第 row 行 [col, col + width) 中是否有值为 1 的单元
+    bool any_in_range(size_t row, size_t col, size_t width) const;
+
+    // 将第 row 行 [col, col + width) 全部置 1
+    void set_range(size_t row, size_t col, size_t width);
+
+    // 将第 row 行 [col, col + width) 全部置 0
+    void clear_range(size_t row, size_t col, size_t width);
+
+private:
+    // 清除每行末尾超出 cols_ 的位
+    void clear_padding();
+
+    Grid<uint64_t> words_;
+    size_t cols_ = 0;
+};
+
+// 64 位字中最低的 1 所在位置，word 不能为 0
+inline unsigned lowest_set_bit(uint64_t word) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+}
+
+}  // namespace submatrix_search
+
+#endif // CPP_SANDBOX_BIT_MASK_HPP
@@ -1,4 +1,16 @@
 #pragma once
 #include <cpp_sandbox/gdal_util_library_export.hpp>
+#include <cpp_sandbox/submatrix_search.hpp>
+#include <gdal.h>
 
 void testGDALAutoCreateWarpedVRT();
+
+// 按块行读取栅格波段并流式查找 x 行 y 列的全 1 窗口，每次只读入与块高度相同的一个条带。
+// 非 0 像元视为 1，0 和等于波段 nodata 值的像元（如填充值 -9999；nodata 为 NaN 时即 NaN 像元）视为 0；
+// 结果与对如此得到的 0/1 网格调用 findSubmatrices 相同
+// @throws std::runtime_error 读取失败时抛出异常
+GDAL_UTIL_LIBRARY_EXPORT void searchRasterBand(
+    GDALRasterBandH band,
+    int x, int y,
+    const submatrix_search::StreamingSubmatrixSearch::Sink& sink,
+    bool checkOverlap = false);
@@ -0,0 +1,158 @@
+#ifndef CPP_SANDBOX_GRID_HPP
+#define CPP_SANDBOX_GRID_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace submatrix_search {
+
+// 网格中一行的视图，不持有数据
+template<typename T>
+class GridRow {
+public:
+    GridRow(T* data, size_t size) : data_(data), size_(size) {}
+
+    T* data() const { return data_; }
+    size_t size() const { return size_; }
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+    T& operator[](size_t index) const { return data_[index]; }
+
+private:
+    T* data_;
+    size_t size_;
+};
+
+// 按行优先连续存放的二维网格。整个网格只分配一次，
+// 每行起始地址按 kAlignment 字节对齐（行跨度 stride 向上取整），便于向量化逐行扫描。
+// 元素类型须为平凡可复制类型，新分配的元素初始化为给定值
+template<typename T>
+class Grid {
+    static_assert(std::is_trivially_copyable<T>::value, "Grid element type must be trivially copyable");
+
+public:
+    static constexpr size_t kAlignment = 64;
+
+    Grid() = default;
+
+    Grid(size_t rows, size_t cols, const T& value = T()) { assign(rows, cols, value); }
+
+    // 由嵌套 vector 构造，所有行的长度须与第一行相同
+    static Grid from_rows(const std::vector<std::vector<T>>& rows) {
+        Grid grid(rows.size(), rows.empty() ? 0 : rows[0].size());
+        for (size_t i = 0; i < rows.size(); ++i) {
+            std::copy(rows[i].begin(), rows[i].end(), grid.row_data(i));
+        }
+        return grid;
+    }
+
+    Grid(const Grid& other) : Grid() {
+        allocate(other.rows_, other.cols_);
+        if (size_in_elements() > 0) {
+            std::memcpy(data_.get(), other.data_.get(), size_in_elements() * sizeof(T));
+        }
+    }
+
+    Grid& operator=(const Grid& other) {
+        if (this != &other) {
+            Grid copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    Grid(Grid&& other) noexcept { swap(other); }
+
+    Grid& operator=(Grid&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    void swap(Grid& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(rows_, other.rows_);
+        std::swap(cols_, other.cols_);
+        std::swap(stride_, other.stride_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    // 调整为 rows x cols 并将所有元素置为 value；容量足够时复用已有内存
+    void assign(size_t rows, size_t cols, const T& value = T()) {
+        reshape(rows, cols);
+        fill(value);
+    }
+
+    // 调整为 rows x cols，不初始化元素，适合随后会被完整覆盖写入的网格；容量足够时复用已有内存
+    void reshape(size_t rows, size_t cols) {
+        const size_t stride = aligned_stride(cols);
+        if (rows * stride > capacity_) {
+            allocate(rows, cols);
+        } else {
+            rows_ = rows;
+            cols_ = cols;
+            stride_ = stride;
+        }
+    }
+
+    void fill(const T& value) { std::fill(data_.get(), data_.get() + size_in_elements(), value); }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    // 相邻两行起始位置之间的元素个数，不小于 cols()
+    size_t stride() const { return stride_; }
+    bool empty() const { return rows_ == 0 || cols_ == 0; }
+
+    T* data() { return data_.get(); }
+    const T* data() const { return data_.get(); }
+
+    T* row_data(size_t row) { return data_.get() + row * stride_; }
+    const T* row_data(size_t row) const { return data_.get() + row * stride_; }
+
+    GridRow<T> row(size_t row) { return GridRow<T>(row_data(row), cols_); }
+    GridRow<const T> row(size_t row) const { return GridRow<const T>(row_data(row), cols_); }
+    GridRow<T> operator[](size_t row) { return this->row(row); }
+    GridRow<const T> operator[](size_t row) const { return this->row(row); }
+
+    T& operator()(size_t row, size_t col) { return data_[row * stride_ + col]; }
+    const T& operator()(size_t row, size_t col) const { return data_[row * stride_ + col]; }
+
+private:
+    struct AlignedDeleter {
+        void operator()(T* pointer) const { ::operator delete(pointer, std::align_val_t(kAlignment)); }
+    };
+
+    static size_t aligned_stride(size_t cols) {
+        constexpr size_t step = kAlignment % sizeof(T) == 0 ? kAlignment / sizeof(T) : 1;
+        return (cols + step - 1) / step * step;
+    }
+
+    size_t size_in_elements() const { return rows_ * stride_; }
+
+    void allocate(size_t rows, size_t cols) {
+        const size_t stride = aligned_stride(cols);
+        T* pointer = nullptr;
+        if (rows * stride > 0) {
+            pointer = static_cast<T*>(::operator new(rows * stride * sizeof(T), std::align_val_t(kAlignment)));
+        }
+        data_.reset(pointer);
+        capacity_ = rows * stride;
+        rows_ = rows;
+        cols_ = cols;
+        stride_ = stride;
+    }
+
+    std::unique_ptr<T[], AlignedDeleter> data_;
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    size_t stride_ = 0;
+    size_t capacity_ = 0;
+};
+
+}  // namespace submatrix_search
+
+#endif // CPP_SANDBOX_GRID_HPP
@@ -0,0 +1,268 @@
+#ifndef CPP_SANDBOX_SUBMATRIX_SEARCH_HPP
+#define CPP_SANDBOX_SUBMATRIX_SEARCH_HPP
+
+#include <cpp_sandbox/bit_mask.hpp>
+#include <cpp_sandbox/grid.hpp>
+#include <cpp_sandbox/submatrix_search_export.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace submatrix_search {
+
+// 构建二维前缀和（summed-area table），sum 为 (m + 1) x (n + 1)，首行首列为 0。
+// grid 应为 0/1 矩阵；uint32_t 版本要求 m * n 不超过 UINT32_MAX，更大的网格使用 uint64_t 版本。
+// 逐行构建，每行按列分块：先在块内求行内累加和，再加上一行同一块的前缀和，块内数据保持在缓存中
+SUBMATRIX_SEARCH_EXPORT void buildPrefixSum(const Grid<int>& grid, Grid<uint32_t>& sum);
+SUBMATRIX_SEARCH_EXPORT void buildPrefixSum(const Grid<int>& grid, Grid<uint64_t>& sum);
+
+// 多线程构建前缀和，结果与 buildPrefixSum 相同；threadCount 为 0 时使用硬件并发数。
+// 两遍构建：先按行带并行求行内累加和，再按列块并行逐行向下累加
+SUBMATRIX_SEARCH_EXPORT void buildPrefixSumParallel(const Grid<int>& grid, Grid<uint32_t>& sum, unsigned threadCount = 0);
+SUBMATRIX_SEARCH_EXPORT void buildPrefixSumParallel(const Grid<int>& grid, Grid<uint64_t>& sum, unsigned threadCount = 0);
+
+// 前缀和可以使用 uint32_t 存放时返回 true，即 rows * cols 不超过 UINT32_MAX
+SUBMATRIX_SEARCH_EXPORT bool prefixSumFitsUint32(size_t rows, size_t cols);
+
+// 查找所有 x 行 y 列的全 1 子矩阵左上角坐标（行优先顺序）；
+// checkOverlap 为 true 时按扫描顺序贪心选取互不重叠的子矩阵。
+// 前缀和写入 sum 供调用方复用，位宽要求同 buildPrefixSum
+SUBMATRIX_SEARCH_EXPORT std::vector<std::pair<int, int>> findSubmatrices(
+    const Grid<int>& grid,
+    int x, int y,
+    Grid<uint32_t>& sum,
+    bool checkOverlap = false
+);
+SUBMATRIX_SEARCH_EXPORT std::vector<std::pair<int, int>> findSubmatrices(
+    const Grid<int>& grid,
+    int x, int y,
+    Grid<uint64_t>& sum,
+    bool checkOverlap = false
+);
+
+// 同上，按网格大小自动选择 uint32_t 或 uint64_t 前缀和
+SUBMATRIX_SEARCH_EXPORT std::vector<std::pair<int, int>> findSubmatrices(
+    const Grid<int>& grid,
+    int x, int y,
+    bool checkOverlap = false
+);
+
+// 多线程版本，结果（含顺序）与 findSubmatrices 完全相同；threadCount 为 0 时使用硬件并发数。
+// 前缀和并行构建，候选行按行带分给各线程，各线程的结果按行带顺序拼接；
+// checkOverlap 的贪心选取依赖扫描顺序，仍在调用线程上串行执行
+SUBMATRIX_SEARCH_EXPORT std::vector<std::pair<int, int>> findSubmatricesParallel(
+    const Grid<int>& grid,
+    int x, int y,
+    bool checkOverlap = false,
+    unsigned threadCount = 0
+);
+
+// 对同一网格反复查找不同大小的窗口：构造时构建一次前缀和，之后每次查询直接在其上扫描，不再重建。
+// 前缀和位宽按网格大小自动选择；构造后不再引用 grid，查询为 const 操作，可在多个线程中同时进行
+class SUBMATRIX_SEARCH_EXPORT SubmatrixQuery {
+public:
+    // threadCount 不为 1 时多线程构建前缀和，0 为硬件并发数
+    explicit SubmatrixQuery(const Grid<int>& grid, unsigned threadCount = 1);
+    ~SubmatrixQuery();
+
+    SubmatrixQuery(SubmatrixQuery&& other) noexcept;
+    SubmatrixQuery& operator=(SubmatrixQuery&& other) noexcept;
+
+    size_t rows() const;
+    size_t cols() const;
+
+    // 以 (row, col) 为左上角的 x 行 y 列窗口中非 0 单元的个数，窗口须在网格范围内
+    uint64_t countOnes(int row, int col, int x, int y) const;
+
+    // 结果（含顺序）与 findSubmatrices(grid, x, y, checkOverlap) 相同
+    std::vector<std::pair<int, int>> find(int x, int y, bool checkOverlap = false) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+// 一次 O(m * n) 预处理后回答任意窗口大小的查询。记录每个单元向下连续 1 的个数（把每行看作直方图）、
+// 右侧第一个更矮的列和以该单元为左上角的最大全 1 正方形边长；x 行 y 列窗口能放在 (i, j) 当且仅当
+// 第 i 行 [j, j + y) 各列向下连续 1 的个数都不小于 x。查询不需要前缀和，也不重建任何表
+class SUBMATRIX_SEARCH_EXPORT WindowSizeIndex {
+public:
+    explicit WindowSizeIndex(const Grid<int>& grid);
+    ~WindowSizeIndex();
+
+    WindowSizeIndex(WindowSizeIndex&& other) noexcept;
+    WindowSizeIndex& operator=(WindowSizeIndex&& other) noexcept;
+
+    size_t rows() const;
+    size_t cols() const;
+
+    // 以 (row, col) 为左上角的最大全 1 正方形边长，O(1)
+    int largestSquare(int row, int col) const;
+
+    // 以 (row, col) 为左上角的所有极大全 1 矩形的 (行数, 列数)，按行数降序、列数升序排列，
+    // 任何能放在该处的窗口都不超过其中某一项；沿右侧第一个更矮的列跳转，耗时与结果项数成正比
+    std::vector<std::pair<int, int>> maximalSizes(int row, int col) const;
+
+    // 结果（含顺序）与 findSubmatrices(grid, x, y) 相同；跳过最高列不足 x 的行，其余行从候选窗口的
+    // 最右列向左检查，遇到不足 x 的列时一次跳过最多 y 个起点。每列至多检查一次，耗时不随结果数减少：
+    // 最坏（各行都有足够高的列且不足 x 的列稀疏）为 O(m * n)，不足 x 的列密集时约为 O(m * n / y + 结果数)
+    std::vector<std::pair<int, int>> find(int x, int y) const;
+
+    // 所有窗口大小的左上角个数，counts(x, y) 等于 find(x, y).size()，结果为 (maxX + 1) x (maxY + 1)，
+    // 第 0 行、第 0 列为 0。每行用单调栈求出每个高度下的连续列段，总耗时 O(m * n + maxX * n)
+    Grid<uint64_t> countAllSizes(int maxX, int maxY) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+// 支持单元修改的二维树状数组（Fenwick tree）：单元修改与任意窗口求和均为 O(log m * log n)，
+// 适合只有少量单元变化、不值得重建整个前缀和的网格。由网格构造为 O(m * n)
+class SUBMATRIX_SEARCH_EXPORT FenwickGrid {
+public:
+    FenwickGrid();
+    explicit FenwickGrid(const Grid<int>& grid);
+    ~FenwickGrid();
+
+    FenwickGrid(const FenwickGrid& other);
+    FenwickGrid& operator=(const FenwickGrid& other);
+    FenwickGrid(FenwickGrid&& other) noexcept;
+    FenwickGrid& operator=(FenwickGrid&& other) noexcept;
+
+    size_t rows() const;
+    size_t cols() const;
+
+    int get(int row, int col) const;
+    void add(int row, int col, int delta);
+    void set(int row, int col, int value);
+
+    // 左上角 rows x cols 区域的和
+    int64_t prefixSum(size_t rows, size_t cols) const;
+
+    // 以 (row, col) 为左上角的 x 行 y 列窗口的和，窗口须在网格范围内
+    int64_t windowSum(int row, int col, int x, int y) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+// 一个单元的新值
+struct CellChange {
+    int row;
+    int col;
+    int value;
+};
+
+// 跟踪 x 行 y 列全 1 窗口的左上角集合，单元变化后只重新检查受影响的区域：
+// 单元 (r, c) 只影响左上角在 [r - x + 1, r] x [c - y + 1, c] 内的窗口。
+// 变为 0 的单元使该区域内的窗口全部失效，无需检查；变为非 0 的单元在 FenwickGrid 上逐个重新求和
+class SUBMATRIX_SEARCH_EXPORT WindowTracker {
+public:
+    WindowTracker(const Grid<int>& grid, int x, int y);
+    ~WindowTracker();
+
+    WindowTracker(WindowTracker&& other) noexcept;
+    WindowTracker& operator=(WindowTracker&& other) noexcept;
+
+    int windowRows() const;
+    int windowCols() const;
+    const FenwickGrid& grid() const;
+
+    // 应用一批单元修改并更新窗口集合；同一单元出现多次时以最后一次为准
+    void update(const std::vector<CellChange>& changes);
+
+    bool isValid(int row, int col) const;
+
+    // 当前全部窗口，按位表示，第 (i, j) 位为 1 表示以 (i, j) 为左上角的窗口全为非 0，与网格同样大小
+    const BitMask& validPositions() const;
+
+    // 结果（含顺序）与对当前网格调用 findSubmatrices(grid, x, y) 相同
+    std::vector<std::pair<int, int>> positions() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+// 逐行（或逐条带）读入网格、边读边输出全 1 窗口的流式查找，适合无法整体载入内存的大栅格。
+// 只保存每列到当前行为止向上连续非 0 的个数，读入第 r 行后即可判定左上角在第 r - x + 1 行的所有窗口，
+// 内存为 O(n)，与行数无关。输出顺序及 checkOverlap 的选取结果与 findSubmatrices 完全相同
+class SUBMATRIX_SEARCH_EXPORT StreamingSubmatrixSearch {
+public:
+    // 每个有窗口的左上角行调用一次，cols 为该行所有左上角的列号（升序）
+    using Sink = std::function<void(int row, const std::vector<int>& cols)>;
+
+    StreamingSubmatrixSearch(size_t cols, int x, int y, Sink sink, bool checkOverlap = false);
+    ~StreamingSubmatrixSearch();
+
+    StreamingSubmatrixSearch(StreamingSubmatrixSearch&& other) noexcept;
+    StreamingSubmatrixSearch& operator=(StreamingSubmatrixSearch&& other) noexcept;
+
+    size_t cols() const;
+    // 已读入的行数
+    size_t rowsRead() const;
+
+    // 读入下一行，共 cols() 个单元，非 0 视为 1
+    void pushRow(const int* cells);
+    void pushRow(const uint8_t* cells);
+
+    // 依次读入一个条带的 rows 行，rowStride 为相邻两行的元素距离
+    void pushRows(const int* cells, size_t rows, size_t rowStride);
+    void pushRows(const uint8_t* cells, size_t rows, size_t rowStride);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+#ifndef _WIN32
+// 在每单元一个字节、按行优先存放的原始掩膜文件上流式查找，行数为文件大小除以 cols。
+// 文件通过 mmap 只读映射，每处理完 stripRows 行即释放已读部分的映射页，常驻内存不随文件大小增长
+// @throws std::runtime_error 文件无法打开、映射，或大小不是 cols 的整数倍时抛出异常
+SUBMATRIX_SEARCH_EXPORT void searchRawMaskFile(
+    const std::string& path,
+    size_t cols,
+    int x, int y,
+    const StreamingSubmatrixSearch::Sink& sink,
+    bool checkOverlap = false,
+    size_t stripRows = 1024
+);
+#endif
+
+// 按位压缩掩膜上的全 1 窗口：结果中第 (i, j) 位为 1 表示以 (i, j) 为左上角的 x 行 y 列窗口全为 1。
+// 先在每行内用移位与运算求出长度为 y 的连续 1，再跨行求 x 行的与，均按倍增方式每次处理 64 列
+SUBMATRIX_SEARCH_EXPORT BitMask allOnesWindows(const BitMask& mask, int x, int y);
+
+// 与稠密版本结果相同，但直接在按位压缩的掩膜上查找，不需要前缀和
+SUBMATRIX_SEARCH_EXPORT std::vector<std::pair<int, int>> findSubmatrices(
+    const BitMask& mask,
+    int x, int y,
+    bool checkOverlap = false
+);
+
+// 对子矩阵左上角坐标进行聚类，能通过上下左右平移连接起来的归为一类。
+// 在按行优先排序的候选上用并查集做两遍连通域标记；
+// 聚类按其首个坐标在 rects 中出现的顺序排列，类内坐标保持 rects 中的顺序，重复的坐标只保留一个
+SUBMATRIX_SEARCH_EXPORT std::vector<std::vector<std::pair<int, int>>> clusterSubmatrices(
+    const std::vector<std::pair<int, int>>& rects, int x, int y);
+
+// 多线程版本，结果与 clusterSubmatrices 完全相同；threadCount 为 0 时使用硬件并发数。
+// 候选按整行切分为行带分别标记，再合并相邻行带交界处的两行
+SUBMATRIX_SEARCH_EXPORT std::vector<std::vector<std::pair<int, int>>> clusterSubmatricesParallel(
+    const std::vector<std::pair<int, int>>& rects, int x, int y,
+    unsigned threadCount = 0);
+
+// 对每个聚类贪心选取互不重叠的子矩阵，返回每类中选中的左上角坐标
+SUBMATRIX_SEARCH_EXPORT std::vector<std::vector<std::pair<int, int>>> getNonOverlappingInClusters(
+    const std::vector<std::vector<std::pair<int, int>>>& clusters,
+    int x, int y
+);
+
+}  // namespace submatrix_search
+
+#endif // CPP_SANDBOX_SUBMATRIX_SEARCH_HPP
@@ -0,0 +1,75 @@
+#ifndef COMMON_MAPPED_FILE_HPP
+#define COMMON_MAPPED_FILE_HPP
+
+// 只读映射整个文件，供 transcode 和 submatrix_search 共用；仅支持 POSIX 平台
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class MappedFile {
+public:
+    // 按顺序读取的访问提示在映射后立即设置
+    explicit MappedFile(const std::string& path) {
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+        }
+        struct stat info;
+        if (::fstat(fd_, &info) != 0 || !S_ISREG(info.st_mode)) {
+            ::close(fd_);
+            throw std::runtime_error(path + " is not a regular file");
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ > 0) {
+            data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (data_ == MAP_FAILED) {
+                const int error = errno;
+                ::close(fd_);
+                throw std::runtime_error("cannot map " + path + ": " + std::strerror(error));
+            }
+            ::madvise(data_, size_, MADV_SEQUENTIAL);
+        }
+    }
+
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            ::munmap(data_, size_);
+        }
+        ::close(fd_);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    int fd() const { return fd_; }
+    size_t size() const { return size_; }
+    const uint8_t* data() const { return static_cast<const uint8_t*>(data_); }
+    std::string_view bytes() const { return std::string_view(static_cast<const char*>(data_), size_); }
+
+    // 释放 [0, end) 中整页的映射，之后不再访问这部分数据；流式读取大文件时使常驻内存保持在一个窗口内
+    void release(size_t end) {
+        const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t aligned = end / page * page;
+        if (aligned > released_) {
+            ::madvise(static_cast<char*>(data_) + released_, aligned - released_, MADV_DONTNEED);
+            released_ = aligned;
+        }
+    }
+
+private:
+    int fd_ = -1;
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    size_t released_ = 0;
+};
+
+#endif // COMMON_MAPPED_FILE_HPP
@@ -3,6 +3,12 @@
 #include <gdal_priv.h>
 #include <gdal_alg.h>
 #include <gdalwarper.h>
+#include <cpl_error.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
 
 void testGDALAutoCreateWarpedVRT()
 {
@@ -29,3 +35,33 @@ void testGDALAutoCreateWarpedVRT()
     GDALClose(warpedDataset);
     GDALClose(dataset);
 }
+
+void searchRasterBand(GDALRasterBandH band, int x, int y, const submatrix_search::StreamingSubmatrixSearch::Sink& sink, bool checkOverlap)
+{
+    const int cols = GDALGetRasterBandXSize(band);
+    const int rows = GDALGetRasterBandYSize(band);
+    int blockCols = 0, blockRows = 0;
+    GDALGetBlockSize(band, &blockCols, &blockRows);
+    const int stripRows = std::max(blockRows, 1);
+
+    // 按 Float64 读取，小数和超出 Int32 的值都不会被截断；等于 nodata 的像元（nodata 为 NaN 时即 NaN 像元）视为 0
+    int hasNoData = 0;
+    const double noData = GDALGetRasterNoDataValue(band, &hasNoData);
+    const bool noDataIsNan = hasNoData != 0 && std::isnan(noData);
+    submatrix_search::StreamingSubmatrixSearch search(static_cast<size_t>(cols), x, y, sink, checkOverlap);
+    std::vector<double> values(static_cast<size_t>(cols) * static_cast<size_t>(stripRows));
+    std::vector<uint8_t> strip(values.size());
+    for (int row = 0; row < rows; row += stripRows) {
+        const int count = std::min(stripRows, rows - row);
+        if (GDALRasterIO(band, GF_Read, 0, row, cols, count, values.data(), cols, count, GDT_Float64, 0, 0) != CE_None) {
+            throw std::runtime_error(CPLGetLastErrorMsg());
+        }
+        const size_t cells = static_cast<size_t>(cols) * static_cast<size_t>(count);
+        for (size_t k = 0; k < cells; ++k) {
+            const double value = values[k];
+            const bool isNoData = hasNoData != 0 && (noDataIsNan ? std::isnan(value) : value == noData);
+            strip[k] = value != 0 && !isNoData ? 1 : 0;
+        }
+        search.pushRows(strip.data(), static_cast<size_t>(count), static_cast<size_t>(cols));
+    }
+}
@@ -0,0 +1,152 @@
+#include <cpp_sandbox/ConversionCache.hpp>
+#include <cpp_sandbox/StringConverter.hpp>
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+enum class ConversionCache::Conversion : uint8_t {
+    gb2312_to_utf8,
+    utf8_to_gb2312,
+    ansi_to_utf8,
+    utf8_to_ansi,
+};
+
+namespace {
+
+// 每个缓存项除输入和输出字节外的估算开销（链表节点、哈希表节点、shared_ptr 控制块）
+constexpr size_t kEntryOverhead = 128;
+
+struct EntryKey {
+    size_t hash;
+    uint8_t conversion;
+    std::string_view input;  // 指向链表节点中保存的输入
+
+    bool operator==(const EntryKey& other) const {
+        return hash == other.hash && conversion == other.conversion && input == other.input;
+    }
+};
+
+struct EntryKeyHash {
+    size_t operator()(const EntryKey& key) const { return key.hash; }
+};
+
+struct Entry {
+    std::string input;
+    uint8_t conversion;
+    size_t hash;
+    ConversionCache::Result output;
+    size_t cost;
+};
+
+}  // namespace
+
+struct ConversionCache::Shard {
+    std::mutex mutex;
+    std::list<Entry> entries;  // 表头为最近使用的项
+    std::unordered_map<EntryKey, std::list<Entry>::iterator, EntryKeyHash> index;
+    size_t bytes = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+ConversionCache::ConversionCache(size_t capacity_bytes, size_t shard_count)
+    : shard_count_(std::max<size_t>(shard_count, 1)),
+      shard_capacity_(capacity_bytes / std::max<size_t>(shard_count, 1)) {
+    shards_.reset(new Shard[shard_count_]);
+}
+
+ConversionCache::~ConversionCache() = default;
+
+ConversionCache::Result ConversionCache::gb2312_to_utf8(std::string_view gb2312_str) {
+    return lookup(Conversion::gb2312_to_utf8, gb2312_str,
+                  [](std::string_view input) { return StringConverter::gb2312_to_utf8(input); });
+}
+
+ConversionCache::Result ConversionCache::utf8_to_gb2312(std::string_view utf8_str) {
+    return lookup(Conversion::utf8_to_gb2312, utf8_str,
+                  [](std::string_view input) { return StringConverter::utf8_to_gb2312(input); });
+}
+
+ConversionCache::Result ConversionCache::ansi_to_utf8(std::string_view ansi_str) {
+    return lookup(Conversion::ansi_to_utf8, ansi_str,
+                  [](std::string_view input) { return StringConverter::ansi_to_utf8(input); });
+}
+
+ConversionCache::Result ConversionCache::utf8_to_ansi(std::string_view utf8_str) {
+    return lookup(Conversion::utf8_to_ansi, utf8_str,
+                  [](std::string_view input) { return StringConverter::utf8_to_ansi(input); });
+}
+
+ConversionCache::Stats ConversionCache::stats() const {
+    Stats result;
+    for (size_t i = 0; i < shard_count_; ++i) {
+        Shard& shard = shards_[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        result.hits += shard.hits;
+        result.misses += shard.misses;
+        result.evictions += shard.evictions;
+        result.entries += shard.entries.size();
+        result.bytes += shard.bytes;
+    }
+    return result;
+}
+
+void ConversionCache::clear() {
+    for (size_t i = 0; i < shard_count_; ++i) {
+        Shard& shard = shards_[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.index.clear();
+        shard.entries.clear();
+        shard.bytes = 0;
+    }
+}
+
+template<typename Func>
+ConversionCache::Result ConversionCache::lookup(Conversion conversion, std::string_view input, Func convert) {
+    const uint8_t conversion_id = static_cast<uint8_t>(conversion);
+    const size_t hash = std::hash<std::string_view>()(input) ^ (static_cast<size_t>(conversion_id) * 0x9E3779B97F4A7C15ull);
+    // 分片用哈希的高位，哈希表桶用低位，避免同一分片内的键集中到少数桶
+    Shard& shard = shards_[(hash >> (sizeof(size_t) * 4)) % shard_count_];
+    const EntryKey key{hash, conversion_id, input};
+
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(key);
+        if (found != shard.index.end()) {
+            ++shard.hits;
+            shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+            return found->second->output;
+        }
+        ++shard.misses;
+    }
+
+    // 转换在锁外进行，其它线程可以同时查找同一分片
+    Result output = std::make_shared<const std::string>(convert(input));
+    const size_t cost = input.size() + output->size() + kEntryOverhead;
+    if (cost > shard_capacity_) {
+        return output;
+    }
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto found = shard.index.find(key);
+    if (found != shard.index.end()) {
+        // 其它线程已经插入了相同的项
+        return found->second->output;
+    }
+    shard.entries.push_front(Entry{std::string(input), conversion_id, hash, output, cost});
+    shard.index.emplace(EntryKey{hash, conversion_id, shard.entries.front().input}, shard.entries.begin());
+    shard.bytes += cost;
+
+    while (shard.bytes > shard_capacity_) {
+        Entry& victim = shard.entries.back();
+        shard.index.erase(EntryKey{victim.hash, victim.conversion, victim.input});
+        shard.bytes -= victim.cost;
+        shard.entries.pop_back();
+        ++shard.evictions;
+    }
+    return output;
+}
@@ -0,0 +1,303 @@
+#include "GbkCodec.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace gbk_codec {
+
+namespace {
+
+// 双字节字符的首字节范围 0x81-0xFE，尾字节范围 0x40-0xFE
+constexpr unsigned kGbkLeadMin = 0x81;
+constexpr unsigned kGbkTrailMin = 0x40;
+constexpr size_t kGbkLeadCount = 0xFE - kGbkLeadMin + 1;
+constexpr size_t kGbkTrailCount = 0xFE - kGbkTrailMin + 1;
+
+#include "GbkTables.inc"
+
+// 代码页 936 的单字节扩展：0x80 对应欧元符号
+constexpr unsigned char kEuroByte = 0x80;
+constexpr uint32_t kEuroCodePoint = 0x20AC;
+
+// 编码表按 Unicode 高字节分页，只为出现过的页分配 256 项，第 0 页保留为空页
+constexpr size_t count_encode_pages() {
+    bool used[256] = {};
+    size_t count = 1;
+    for (size_t lead = 0; lead < kGbkLeadCount; ++lead) {
+        for (size_t trail = 0; trail < kGbkTrailCount; ++trail) {
+            const uint16_t code_point = kGbkDecodeTable[lead][trail];
+            if (code_point != 0 && !used[code_point >> 8]) {
+                used[code_point >> 8] = true;
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+constexpr size_t kEncodePageCount = count_encode_pages();
+
+struct EncodeTable {
+    uint8_t page_index[256];
+    uint16_t pages[kEncodePageCount][256];  // 值为 (首字节 << 8) | 尾字节，0 表示无法编码
+};
+
+// 解码表是双射，编译期直接求逆得到编码表
+constexpr EncodeTable build_encode_table() {
+    EncodeTable table{};
+    size_t next_page = 1;
+    for (size_t lead = 0; lead < kGbkLeadCount; ++lead) {
+        for (size_t trail = 0; trail < kGbkTrailCount; ++trail) {
+            const uint16_t code_point = kGbkDecodeTable[lead][trail];
+            if (code_point == 0) {
+                continue;
+            }
+            const size_t high = code_point >> 8;
+            if (table.page_index[high] == 0) {
+                table.page_index[high] = static_cast<uint8_t>(next_page++);
+            }
+            table.pages[table.page_index[high]][code_point & 0xFF] =
+                static_cast<uint16_t>(((lead + kGbkLeadMin) << 8) | (trail + kGbkTrailMin));
+        }
+    }
+    return table;
+}
+
+constexpr EncodeTable kEncodeTable = build_encode_table();
+
+// 解码一个非 ASCII 字符，错误分类与 iconv 一致：末尾孤立的首字节为 incomplete
+inline Status decode_char(const unsigned char* input, size_t available, uint32_t& code_point, size_t& size) {
+    const unsigned char lead = input[0];
+    if (lead == kEuroByte) {
+        code_point = kEuroCodePoint;
+        size = 1;
+        return Status::ok;
+    }
+    if (lead == 0xFF) {
+        return Status::invalid;
+    }
+    if (available < 2) {
+        return Status::incomplete;
+    }
+    const unsigned char trail = input[1];
+    if (trail < kGbkTrailMin || trail == 0xFF) {
+        return Status::invalid;
+    }
+    code_point = kGbkDecodeTable[lead - kGbkLeadMin][trail - kGbkTrailMin];
+    size = 2;
+    return code_point != 0 ? Status::ok : Status::invalid;
+}
+
+// 编码一个非 ASCII 码点，无法编码时返回 0
+inline size_t encode_char(uint32_t code_point, char* output) {
+    if (code_point == kEuroCodePoint) {
+        output[0] = static_cast<char>(kEuroByte);
+        return 1;
+    }
+    if (code_point > 0xFFFF) {
+        return 0;
+    }
+    const uint16_t bytes = kEncodeTable.pages[kEncodeTable.page_index[code_point >> 8]][code_point & 0xFF];
+    if (bytes == 0) {
+        return 0;
+    }
+    output[0] = static_cast<char>(bytes >> 8);
+    output[1] = static_cast<char>(bytes & 0xFF);
+    return 2;
+}
+
+// 保证 output 在 used 之后至少还有 needed 个单元可写
+template<typename StringType>
+inline void ensure_room(StringType& output, size_t used, size_t needed) {
+    if (used + needed > output.size()) {
+        output.resize(std::max(output.size() * 2, used + needed));
+    }
+}
+
+}  // namespace
+
+Result append_gbk_to_wide(const char* input, size_t length, std::wstring& output) {
+    const auto* in = reinterpret_cast<const unsigned char*>(input);
+    const size_t base = output.size();
+    // 每个输入字节至多产生一个宽字符
+    output.resize(base + length);
+    size_t i = 0;
+    size_t o = base;
+    while (i < length) {
+        if (in[i] < 0x80) {
+            const size_t ascii = utf8_transcoder::ascii_prefix_length(input + i, length - i);
+            for (size_t k = 0; k < ascii; ++k) {
+                output[o + k] = static_cast<wchar_t>(in[i + k]);
+            }
+            i += ascii;
+            o += ascii;
+            continue;
+        }
+        uint32_t code_point = 0;
+        size_t size = 0;
+        const Status status = decode_char(in + i, length - i, code_point, size);
+        if (status != Status::ok) {
+            output.resize(o);
+            return Result{status, i, o - base};
+        }
+        output[o++] = static_cast<wchar_t>(code_point);
+        i += size;
+    }
+    output.resize(o);
+    return Result{Status::ok, i, o - base};
+}
+
+Result append_wide_to_gbk(const wchar_t* input, size_t length, std::string& output) {
+    const size_t base = output.size();
+    output.resize(base + length);
+    size_t o = base;
+    for (size_t i = 0; i < length; ++i) {
+        const uint32_t code_point = static_cast<uint32_t>(input[i]);
+        if (code_point < 0x80) {
+            ensure_room(output, o, 1);
+            output[o++] = static_cast<char>(code_point);
+            continue;
+        }
+        ensure_room(output, o, 2);
+        const size_t size = encode_char(code_point, &output[o]);
+        if (size == 0) {
+            output.resize(o);
+            return Result{Status::invalid, i, o - base};
+        }
+        o += size;
+    }
+    output.resize(o);
+    return Result{Status::ok, length, o - base};
+}
+
+Result append_gbk_to_utf8(const char* input, size_t length, std::string& output) {
+    const auto* in = reinterpret_cast<const unsigned char*>(input);
+    const size_t base = output.size();
+    // 双字节字符转为 UTF-8 至多 3 字节，按 1.5 倍预估，欧元符号等情况再扩容
+    output.resize(base + length + length / 2);
+    size_t i = 0;
+    size_t o = base;
+    while (i < length) {
+        if (in[i] < 0x80) {
+            const size_t ascii = utf8_transcoder::ascii_prefix_length(input + i, length - i);
+            ensure_room(output, o, ascii);
+            std::memcpy(&output[o], input + i, ascii);
+            i += ascii;
+            o += ascii;
+            continue;
+        }
+        uint32_t code_point = 0;
+        size_t size = 0;
+        const Status status = decode_char(in + i, length - i, code_point, size);
+        if (status != Status::ok) {
+            output.resize(o);
+            return Result{status, i, o - base};
+        }
+        ensure_room(output, o, 3);
+        o += utf8_transcoder::encode_code_point(code_point, &output[o]);
+        i += size;
+    }
+    output.resize(o);
+    return Result{Status::ok, i, o - base};
+}
+
+Result gbk_to_utf8_length(const char* input, size_t length) {
+    const auto* in = reinterpret_cast<const unsigned char*>(input);
+    size_t i = 0;
+    size_t o = 0;
+    while (i < length) {
+        if (in[i] < 0x80) {
+            const size_t ascii = utf8_transcoder::ascii_prefix_length(input + i, length - i);
+            i += ascii;
+            o += ascii;
+            continue;
+        }
+        uint32_t code_point = 0;
+        size_t size = 0;
+        const Status status = decode_char(in + i, length - i, code_point, size);
+        if (status != Status::ok) {
+            return Result{status, i, o};
+        }
+        // 码表中的码点都在基本多文种平面内，UTF-8 至多 3 字节
+        o += code_point < 0x80 ? 1 : code_point < 0x800 ? 2 : 3;
+        i += size;
+    }
+    return Result{Status::ok, i, o};
+}
+
+size_t gbk_to_utf8(const char* input, size_t length, char* output) {
+    const auto* in = reinterpret_cast<const unsigned char*>(input);
+    size_t i = 0;
+    size_t o = 0;
+    while (i < length) {
+        if (in[i] < 0x80) {
+            const size_t ascii = utf8_transcoder::ascii_prefix_length(input + i, length - i);
+            std::memcpy(output + o, input + i, ascii);
+            i += ascii;
+            o += ascii;
+            continue;
+        }
+        uint32_t code_point = 0;
+        size_t size = 0;
+        decode_char(in + i, length - i, code_point, size);
+        o += utf8_transcoder::encode_code_point(code_point, output + o);
+        i += size;
+    }
+    return o;
+}
+
+Result append_utf8_to_gbk(const char* input, size_t length, std::string& output) {
+    const auto* in = reinterpret_cast<const unsigned char*>(input);
+    const size_t base = output.size();
+    // 每个 UTF-8 字符编码为 GBK 后不会变长
+    output.resize(base + length);
+    size_t i = 0;
+    size_t o = base;
+    while (i < length) {
+        if (in[i] < 0x80) {
+            const size_t ascii = utf8_transcoder::ascii_prefix_length(input + i, length - i);
+            ensure_room(output, o, ascii);
+            std::memcpy(&output[o], input + i, ascii);
+            i += ascii;
+            o += ascii;
+            continue;
+        }
+        uint32_t code_point = 0;
+        size_t size = 0;
+        const Status status = utf8_transcoder::decode_sequence(in + i, length - i, code_point, size);
+        if (status != Status::ok) {
+            output.resize(o);
+            return Result{status, i, o - base};
+        }
+        const size_t written = encode_char(code_point, &output[o]);
+        if (written == 0) {
+            output.resize(o);
+            return Result{Status::invalid, i, o - base};
+        }
+        o += written;
+        i += size;
+    }
+    output.resize(o);
+    return Result{Status::ok, i, o - base};
+}
+
+bool is_valid_gbk(const char* input, size_t length) {
+    const auto* in = reinterpret_cast<const unsigned char*>(input);
+    size_t i = 0;
+    while (i < length) {
+        i += utf8_transcoder::ascii_prefix_length(input + i, length - i);
+        if (i == length) {
+            break;
+        }
+        uint32_t code_point = 0;
+        size_t size = 0;
+        if (decode_char(in + i, length - i, code_point, size) != Status::ok) {
+            return false;
+        }
+        i += size;
+    }
+    return true;
+}
+
+}  // namespace gbk_codec
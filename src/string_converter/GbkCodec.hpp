@@ -0,0 +1,77 @@
+#ifndef GBK_CODEC_H
+#define GBK_CODEC_H
+
+#include "Utf8Transcoder.hpp"
+
+#include <string>
+
+// 内置的 GB2312 / GBK（代码页 936）编解码器，不依赖系统 iconv 的 gconv 模块
+namespace gbk_codec {
+
+using utf8_transcoder::Result;
+using utf8_transcoder::Status;
+
+/**
+ * 将 GBK 编码的字节追加解码到宽字符串
+ * @param input GBK 字节
+ * @param length 输入字节数
+ * @param output 输出宽字符串，结果追加到末尾
+ * @return 转换结果，出错时 output 的内容未定义
+ */
+Result append_gbk_to_wide(const char* input, size_t length, std::wstring& output);
+
+/**
+ * 将宽字符追加编码为 GBK
+ * @param input 宽字符
+ * @param length 输入字符数
+ * @param output 输出字符串，结果追加到末尾
+ * @return 转换结果，出错时 output 的内容未定义
+ */
+Result append_wide_to_gbk(const wchar_t* input, size_t length, std::string& output);
+
+/**
+ * 将 GBK 编码的字节追加转换为 UTF-8
+ * @param input GBK 字节
+ * @param length 输入字节数
+ * @param output 输出字符串，结果追加到末尾
+ * @return 转换结果，出错时 output 的内容未定义
+ */
+Result append_gbk_to_utf8(const char* input, size_t length, std::string& output);
+
+/**
+ * 计算 GBK 编码的字节转换为 UTF-8 后的字节数，同时校验输入
+ * @param input GBK 字节
+ * @param length 输入字节数
+ * @return 转换结果，成功时 written 为所需的 UTF-8 字节数
+ */
+Result gbk_to_utf8_length(const char* input, size_t length);
+
+/**
+ * 将已通过 gbk_to_utf8_length 校验的 GBK 字节转换为 UTF-8
+ * @param input GBK 字节
+ * @param length 输入字节数
+ * @param output 输出缓冲区，容量至少为 gbk_to_utf8_length 返回的字节数
+ * @return 写出的字节数
+ */
+size_t gbk_to_utf8(const char* input, size_t length, char* output);
+
+/**
+ * 将 UTF-8 编码的字节追加转换为 GBK
+ * @param input UTF-8 字节
+ * @param length 输入字节数
+ * @param output 输出字符串，结果追加到末尾
+ * @return 转换结果，出错时 output 的内容未定义
+ */
+Result append_utf8_to_gbk(const char* input, size_t length, std::string& output);
+
+/**
+ * 校验 input 是否为合法的 GBK（代码页 936）编码
+ * @param input 输入字节
+ * @param length 输入字节数
+ * @return 合法时返回 true，末尾孤立的首字节视为不合法
+ */
+bool is_valid_gbk(const char* input, size_t length);
+
+}  // namespace gbk_codec
+
+#endif // GBK_CODEC_H
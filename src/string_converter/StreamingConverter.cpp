@@ -0,0 +1,204 @@
+#include <cpp_sandbox/StreamingConverter.hpp>
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+#include <errno.h>
+#include <iconv.h>
+
+namespace {
+
+// 与 StringConverter 内置的 GB2312 编解码器使用同一张代码页 936 映射表
+constexpr const char* kGb2312Encoding = "CP936";
+
+// 输出缓冲区至少要能放下任意编码的一个完整字符
+constexpr size_t kMinBufferSize = 16;
+
+inline iconv_t to_iconv(void* descriptor) {
+    return static_cast<iconv_t>(descriptor);
+}
+
+}  // namespace
+
+StreamingConverter::StreamingConverter(std::string_view from_encoding, std::string_view to_encoding,
+                                       size_t buffer_size)
+    : from_encoding_(from_encoding),
+      to_encoding_(to_encoding),
+      buffer_(std::max(buffer_size, kMinBufferSize)) {
+    iconv_t cd = iconv_open(to_encoding_.c_str(), from_encoding_.c_str());
+    if (cd == (iconv_t)-1) {
+        throw std::runtime_error("Failed to open iconv for conversion from " + from_encoding_ + " to " + to_encoding_);
+    }
+    descriptor_ = cd;
+}
+
+StreamingConverter::~StreamingConverter() {
+    if (descriptor_ != nullptr) {
+        iconv_close(to_iconv(descriptor_));
+    }
+}
+
+StreamingConverter::StreamingConverter(StreamingConverter&& other) noexcept
+    : descriptor_(std::exchange(other.descriptor_, nullptr)),
+      from_encoding_(std::move(other.from_encoding_)),
+      to_encoding_(std::move(other.to_encoding_)),
+      buffer_(std::move(other.buffer_)),
+      used_(std::exchange(other.used_, 0)),
+      pending_size_(std::exchange(other.pending_size_, 0)) {
+    std::memcpy(pending_, other.pending_, pending_size_);
+}
+
+StreamingConverter& StreamingConverter::operator=(StreamingConverter&& other) noexcept {
+    if (this != &other) {
+        if (descriptor_ != nullptr) {
+            iconv_close(to_iconv(descriptor_));
+        }
+        descriptor_ = std::exchange(other.descriptor_, nullptr);
+        from_encoding_ = std::move(other.from_encoding_);
+        to_encoding_ = std::move(other.to_encoding_);
+        buffer_ = std::move(other.buffer_);
+        used_ = std::exchange(other.used_, 0);
+        pending_size_ = std::exchange(other.pending_size_, 0);
+        std::memcpy(pending_, other.pending_, pending_size_);
+    }
+    return *this;
+}
+
+StreamingConverter StreamingConverter::gb2312_to_utf8(size_t buffer_size) {
+    return StreamingConverter(kGb2312Encoding, "UTF-8", buffer_size);
+}
+
+StreamingConverter StreamingConverter::utf8_to_gb2312(size_t buffer_size) {
+    return StreamingConverter("UTF-8", kGb2312Encoding, buffer_size);
+}
+
+void StreamingConverter::write(std::string_view chunk, const Sink& sink) {
+    // 先用新数据逐字节补全上一块末尾残留的不完整序列
+    while (pending_size_ > 0 && !chunk.empty()) {
+        if (pending_size_ == sizeof(pending_)) {
+            fail(EILSEQ);
+        }
+        pending_[pending_size_++] = chunk.front();
+        chunk.remove_prefix(1);
+
+        const char* input = pending_;
+        size_t input_left = pending_size_;
+        convert(input, input_left, sink);
+        std::memmove(pending_, input, input_left);
+        pending_size_ = input_left;
+    }
+
+    if (pending_size_ == 0 && !chunk.empty()) {
+        const char* input = chunk.data();
+        size_t input_left = chunk.size();
+        if (!convert(input, input_left, sink)) {
+            // 末尾的不完整序列留到下一块
+            if (input_left > sizeof(pending_)) {
+                fail(EILSEQ);
+            }
+            std::memcpy(pending_, input, input_left);
+            pending_size_ = input_left;
+        }
+    }
+
+    flush(sink);
+}
+
+void StreamingConverter::finish(const Sink& sink) {
+    if (pending_size_ > 0) {
+        fail(EINVAL);
+    }
+
+    // 有状态编码（如 UTF-7、ISO-2022）需要输出回到初始移位状态的序列
+    for (;;) {
+        char* out_buf = buffer_.data() + used_;
+        size_t out_left = buffer_.size() - used_;
+        size_t result = iconv(to_iconv(descriptor_), nullptr, nullptr, &out_buf, &out_left);
+        used_ = buffer_.size() - out_left;
+        if (result != (size_t)-1) {
+            break;
+        }
+        if (errno != E2BIG || used_ == 0) {
+            fail(errno);
+        }
+        flush(sink);
+    }
+
+    flush(sink);
+    reset();
+}
+
+void StreamingConverter::reset() {
+    iconv(to_iconv(descriptor_), nullptr, nullptr, nullptr, nullptr);
+    used_ = 0;
+    pending_size_ = 0;
+}
+
+void StreamingConverter::transcode(std::istream& input, std::ostream& output) {
+    const Sink sink = [&output](std::string_view data) {
+        output.write(data.data(), static_cast<std::streamsize>(data.size()));
+    };
+
+    std::vector<char> chunk(buffer_.size());
+    while (input) {
+        input.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        const size_t count = static_cast<size_t>(input.gcount());
+        if (count == 0) {
+            break;
+        }
+        write(std::string_view(chunk.data(), count), sink);
+        if (!output) {
+            reset();
+            throw std::runtime_error("Failed to write converted output");
+        }
+    }
+    if (input.bad()) {
+        reset();
+        throw std::runtime_error("Failed to read input stream");
+    }
+
+    finish(sink);
+    if (!output) {
+        throw std::runtime_error("Failed to write converted output");
+    }
+}
+
+// 转换 input，输出缓冲区写满时交给 sink；遇到不完整序列返回 false，input 指向该序列起始
+bool StreamingConverter::convert(const char*& input, size_t& input_left, const Sink& sink) {
+    while (input_left > 0) {
+        char* in_buf = const_cast<char*>(input);
+        char* out_buf = buffer_.data() + used_;
+        size_t out_left = buffer_.size() - used_;
+        size_t result = iconv(to_iconv(descriptor_), &in_buf, &input_left, &out_buf, &out_left);
+        input = in_buf;
+        used_ = buffer_.size() - out_left;
+        if (result != (size_t)-1) {
+            break;
+        }
+        if (errno == EINVAL) {
+            return false;
+        }
+        if (errno != E2BIG || used_ == 0) {
+            fail(errno);
+        }
+        flush(sink);
+    }
+    return true;
+}
+
+void StreamingConverter::flush(const Sink& sink) {
+    if (used_ > 0) {
+        const size_t size = used_;
+        used_ = 0;
+        sink(std::string_view(buffer_.data(), size));
+    }
+}
+
+void StreamingConverter::fail(int error) {
+    reset();
+    throw std::runtime_error("Failed to convert from " + from_encoding_ + " to " + to_encoding_ + ": " +
+                             std::string(strerror(error)));
+}
@@ -1,5 +1,16 @@
 #include <cpp_sandbox/StringConverter.hpp>
+#include "GbkCodec.hpp"
+#include "Utf8Transcoder.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <new>
 #include <stdexcept>
+#include <thread>
+#include <type_traits>
 #include <vector>
 #include <cstdint>
 
@@ -10,166 +21,776 @@
     #include <codecvt>
     #include <iconv.h>
     #include <errno.h>
+    #include <cstdlib>
     #include <cstring>
+    #include <deque>
+    #include <iterator>
 #endif
 
-// 通用模板函数用于检查空字符串
-template<typename T, typename Func>
-static auto safe_convert(const T& input, Func converter) -> decltype(converter(input)) {
+// 通用模板函数：跳过空字符串，转换失败时将输出恢复为调用前的长度
+template<typename InputType, typename OutputType, typename Func>
+static void safe_append(const InputType& input, OutputType& output, Func converter) {
     if (input.empty()) {
-        return decltype(converter(input))();
+        return;
     }
-    return converter(input);
+    const size_t original_length = output.size();
+    try {
+        converter(input, output);
+    } catch (...) {
+        output.resize(original_length);
+        throw;
+    }
+}
+
+// 多步转换使用的线程局部中间缓冲区，稳定状态下不再分配内存
+static std::wstring& scratch_wstring() {
+    static thread_local std::wstring buffer;
+    buffer.clear();
+    return buffer;
+}
+
+// 并行转换时每块的最小字节数，更小的输入直接串行转换
+static constexpr size_t kParallelMinChunkSize = 256 * 1024;
+
+// UTF-8 分块边界：跳过续字节，停在下一个序列的首字节上
+size_t StringConverter::utf8_chunk_boundary(std::string_view input, size_t position, size_t /*previous*/) {
+    while (position < input.size() && (static_cast<unsigned char>(input[position]) & 0xC0) == 0x80) {
+        ++position;
+    }
+    return std::min(position, input.size());
+}
+
+// GB2312 分块边界：小于 0x81 的字节一定是字符的最后一个字节，
+// 因此从其后（或上一个边界）开始的连续高位字节必定两两成对，按奇偶对齐即可
+size_t StringConverter::gb2312_chunk_boundary(std::string_view input, size_t position, size_t previous) {
+    if (position >= input.size()) {
+        return input.size();
+    }
+    size_t start = position;
+    while (start > previous && static_cast<unsigned char>(input[start - 1]) >= 0x81) {
+        --start;
+    }
+    return position + ((position - start) & 1);
+}
+
+// 并行转换共用的常驻线程池：首次使用时创建硬件并发数 - 1 个线程，之后各次调用复用，不再逐次创建线程。
+// 同一时刻只服务一个调用；池正忙（其它线程正在并行转换）时调用方在自己的线程上依次执行各任务
+class ConversionThreadPool {
+public:
+    static ConversionThreadPool& instance() {
+        static ConversionThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return pool;
+    }
+
+    ~ConversionThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    ConversionThreadPool(const ConversionThreadPool&) = delete;
+    ConversionThreadPool& operator=(const ConversionThreadPool&) = delete;
+
+    // 在调用线程和池中线程上执行 task(0) ... task(count - 1)，任务按原子计数领取，全部完成后返回；
+    // task 不能抛出异常
+    void run(size_t count, const std::function<void(size_t)>& task) {
+        std::unique_lock<std::mutex> busy(run_mutex_, std::try_to_lock);
+        if (!busy.owns_lock() || workers_.empty() || count <= 1) {
+            for (size_t i = 0; i < count; ++i) {
+                task(i);
+            }
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            count_ = count;
+            next_.store(0, std::memory_order_relaxed);
+            ++generation_;
+        }
+        wake_.notify_all();
+        drain(task, count);
+
+        // 等待领取到本轮任务的线程全部退出，之后 task 才能失效
+        std::unique_lock<std::mutex> lock(mutex_);
+        task_ = nullptr;
+        idle_.wait(lock, [this] { return active_ == 0; });
+    }
+
+private:
+    explicit ConversionThreadPool(size_t worker_count) {
+        workers_.reserve(worker_count);
+        for (size_t i = 0; i < worker_count; ++i) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    void drain(const std::function<void(size_t)>& task, size_t count) {
+        for (size_t i = next_.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next_.fetch_add(1, std::memory_order_relaxed)) {
+            task(i);
+        }
+    }
+
+    void work() {
+        size_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            wake_.wait(lock, [&] { return stopping_ || (generation_ != seen && task_ != nullptr); });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+            const std::function<void(size_t)>* task = task_;
+            const size_t count = count_;
+            ++active_;
+            lock.unlock();
+            drain(*task, count);
+            lock.lock();
+            if (--active_ == 0) {
+                idle_.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    const std::function<void(size_t)>* task_ = nullptr;
+    size_t count_ = 0;
+    size_t generation_ = 0;
+    size_t active_ = 0;
+    bool stopping_ = false;
+    std::atomic<size_t> next_{0};
+};
+
+// 在线程池上执行 func(0) ... func(count - 1)，func 不能抛出异常
+template<typename Func>
+static void run_parallel(size_t count, const Func& func) {
+    ConversionThreadPool::instance().run(count, std::function<void(size_t)>(std::cref(func)));
+}
+
+// 合法 UTF-8 解码为 wchar_t 后的单元数：每个首字节一个字符，wchar_t 为 UTF-16 时四字节序列占两个单元
+static utf8_transcoder::Result utf8_to_wide_length(std::string_view input) {
+    if (!utf8_transcoder::is_valid(input.data(), input.size())) {
+        return utf8_transcoder::Result{utf8_transcoder::Status::invalid, 0, 0};
+    }
+    size_t units = 0;
+    for (const char c : input) {
+        const unsigned char byte = static_cast<unsigned char>(c);
+        units += (byte & 0xC0) != 0x80;
+        if (sizeof(wchar_t) == 2) {
+            units += byte >= 0xF0;
+        }
+    }
+    return utf8_transcoder::Result{utf8_transcoder::Status::ok, input.size(), units};
+}
+
+// 将已通过 utf8_to_wide_length 校验的 UTF-8 解码到 output
+static void utf8_to_wide_into(std::string_view input, wchar_t* output) {
+#ifdef STRING_CONVERTER_NATIVE_UTF32
+    utf8_transcoder::utf8_to_wide(input.data(), input.size(), output);
+#else
+    const auto* in = reinterpret_cast<const unsigned char*>(input.data());
+    for (size_t i = 0; i < input.size();) {
+        uint32_t code_point = in[i];
+        size_t size = 1;
+        if (code_point >= 0x80) {
+            utf8_transcoder::decode_sequence(in + i, input.size() - i, code_point, size);
+        }
+        if (code_point > 0xFFFF) {
+            code_point -= 0x10000;
+            *output++ = static_cast<wchar_t>(0xD800 + (code_point >> 10));
+            *output++ = static_cast<wchar_t>(0xDC00 + (code_point & 0x3FF));
+        } else {
+            *output++ = static_cast<wchar_t>(code_point);
+        }
+        i += size;
+    }
+#endif
+}
+
+static void gb2312_to_utf8_into(std::string_view input, char* output) {
+    gbk_codec::gbk_to_utf8(input.data(), input.size(), output);
+}
+
+static utf8_transcoder::Result gb2312_to_utf8_length(std::string_view input) {
+    return gbk_codec::gbk_to_utf8_length(input.data(), input.size());
+}
+
+// 按安全字符边界分块并行转换：第一遍在线程池上校验各块并求出输出长度，按前缀和一次分配好结果，
+// 第二遍各块直接转换到结果中自己的位置，不经过中间缓冲区。
+// 有块不合法时串行调用 append 重做整个输入，使错误信息与串行版本完全一致
+template<typename OutputType, typename FindBoundary, typename MeasureFunc, typename ConvertFunc, typename AppendFunc>
+static OutputType parallel_convert(std::string_view input, unsigned int thread_count, FindBoundary find_boundary,
+                                   MeasureFunc measure, ConvertFunc convert_into, AppendFunc append) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const size_t target_chunks = std::min<size_t>(thread_count, input.size() / kParallelMinChunkSize);
+
+    std::vector<size_t> bounds{0};
+    for (size_t i = 1; i < target_chunks; ++i) {
+        const size_t boundary = find_boundary(input, input.size() / target_chunks * i, bounds.back());
+        if (boundary > bounds.back() && boundary < input.size()) {
+            bounds.push_back(boundary);
+        }
+    }
+    bounds.push_back(input.size());
+
+    OutputType output;
+    const size_t chunk_count = bounds.size() - 1;
+    if (chunk_count <= 1) {
+        append(input, output);
+        return output;
+    }
+
+    std::vector<size_t> offsets(chunk_count + 1, 0);
+    std::vector<char> valid(chunk_count, 0);
+    run_parallel(chunk_count, [&](size_t i) {
+        const utf8_transcoder::Result result = measure(input.substr(bounds[i], bounds[i + 1] - bounds[i]));
+        valid[i] = result.status == utf8_transcoder::Status::ok;
+        offsets[i + 1] = result.written;
+    });
+    if (std::find(valid.begin(), valid.end(), 0) != valid.end()) {
+        append(input, output);
+        return output;
+    }
+
+    for (size_t i = 0; i < chunk_count; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+    output.resize(offsets.back());
+    run_parallel(chunk_count, [&](size_t i) {
+        convert_into(input.substr(bounds[i], bounds[i + 1] - bounds[i]), &output[0] + offsets[i]);
+    });
+    return output;
+}
+
+// 串行转换 inputs[begin, end)，结果追加到 batch 中，整段只预留一次内存
+template<typename CharT, typename AppendFunc>
+static void convert_batch_range(StringSpan inputs, size_t begin, size_t end,
+                                BasicStringBatch<CharT>& batch, AppendFunc append) {
+    size_t total = 0;
+    for (size_t i = begin; i < end; ++i) {
+        total += inputs[i].size();
+    }
+    // 多字节输出按 1.5 倍预留（双字节中文转为 3 字节 UTF-8），宽字符输出不会多于输入字节数
+    batch.data.reserve(batch.data.size() + (sizeof(CharT) == 1 ? total + total / 2 : total));
+    batch.offsets.reserve(batch.offsets.size() + (end - begin));
+    for (size_t i = begin; i < end; ++i) {
+        try {
+            append(inputs[i], batch.data);
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Failed to convert batch element " + std::to_string(i) + ": " + e.what());
+        }
+        batch.offsets.push_back(batch.data.size());
+    }
+}
+
+// 批量转换：大批量按累计字节数均分给多个线程，各段结果按前缀和合并
+template<typename CharT, typename AppendFunc>
+static BasicStringBatch<CharT> convert_batch(StringSpan inputs, unsigned int thread_count, AppendFunc append) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t total = 0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        total += inputs[i].size();
+    }
+    const size_t part_count = std::min({static_cast<size_t>(thread_count), inputs.size(),
+                                        total / kParallelMinChunkSize});
+
+    BasicStringBatch<CharT> batch;
+    if (part_count <= 1) {
+        convert_batch_range(inputs, 0, inputs.size(), batch, append);
+        return batch;
+    }
+
+    std::vector<size_t> bounds{0};
+    size_t accumulated = 0;
+    for (size_t i = 0; i < inputs.size() && bounds.size() < part_count; ++i) {
+        accumulated += inputs[i].size();
+        if (accumulated >= total / part_count * bounds.size()) {
+            bounds.push_back(i + 1);
+        }
+    }
+    bounds.push_back(inputs.size());
+
+    std::vector<BasicStringBatch<CharT>> parts(bounds.size() - 1);
+    std::vector<std::exception_ptr> errors(parts.size());
+    run_parallel(parts.size(), [&](size_t p) {
+        try {
+            convert_batch_range(inputs, bounds[p], bounds[p + 1], parts[p], append);
+        } catch (...) {
+            errors[p] = std::current_exception();
+        }
+    });
+    // 各段按顺序处理，第一个出错的段给出的就是下标最小的失败元素
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    std::vector<size_t> data_offsets(parts.size() + 1, 0);
+    for (size_t p = 0; p < parts.size(); ++p) {
+        data_offsets[p + 1] = data_offsets[p] + parts[p].data.size();
+    }
+    batch.data.resize(data_offsets.back());
+    batch.offsets.resize(inputs.size() + 1);
+    run_parallel(parts.size(), [&](size_t p) {
+        std::copy(parts[p].data.begin(), parts[p].data.end(), batch.data.begin() + data_offsets[p]);
+        for (size_t k = 1; k < parts[p].offsets.size(); ++k) {
+            batch.offsets[bounds[p] + k] = data_offsets[p] + parts[p].offsets[k];
+        }
+    });
+    return batch;
+}
+
+// 不抛出异常的转换：converter 返回转换状态，其它异常（内存不足、系统接口失败）同样转换为错误码
+template<typename InputType, typename OutputType, typename Func>
+static std::error_code try_convert(const InputType& input, OutputType& output, Func converter) noexcept {
+    try {
+        output.clear();
+        const utf8_transcoder::Status status = converter(input, output);
+        if (status == utf8_transcoder::Status::ok) {
+            return std::error_code();
+        }
+        output.clear();
+        return std::make_error_code(status == utf8_transcoder::Status::incomplete
+                                        ? std::errc::invalid_argument
+                                        : std::errc::illegal_byte_sequence);
+    } catch (const std::bad_alloc&) {
+        output.clear();
+        return std::make_error_code(std::errc::not_enough_memory);
+    } catch (...) {
+        output.clear();
+        return std::make_error_code(std::errc::illegal_byte_sequence);
+    }
+}
+
+// 将抛出异常的追加函数包装为返回转换状态的形式，供没有内置转码器的平台使用
+template<typename Func>
+static auto as_status_converter(Func append) {
+    return [append](auto input, auto& output) {
+        append(input, output);
+        return utf8_transcoder::Status::ok;
+    };
 }
 
 #ifdef _WIN32
     // Windows 平台统一转换函数
-    static std::wstring windows_mb_to_wstring(const std::string& input, UINT codepage, const char* operation);
-    static std::string windows_wstring_to_mb(const std::wstring& input, UINT codepage, const char* operation);
+    static void windows_mb_to_wstring(std::string_view input, UINT codepage, const char* operation, std::wstring& output);
+    static void windows_wstring_to_mb(std::wstring_view input, UINT codepage, const char* operation, std::string& output);
     
-    // Windows 平台辅助函数
-    static std::wstring windows_utf8_to_wstring(const std::string& utf8_str);
-    static std::string windows_wstring_to_utf8(const std::wstring& wide_str);
-    static std::wstring windows_ansi_to_wstring(const std::string& ansi_str);
-    static std::string windows_wstring_to_ansi(const std::wstring& wide_str);
-    static std::string windows_utf8_to_ansi(const std::string& utf8_str);
-    static std::string windows_ansi_to_utf8(const std::string& ansi_str);
+    // Windows 平台辅助函数，结果追加到 output 末尾
+    static void windows_utf8_to_wstring(std::string_view utf8_str, std::wstring& output);
+    static void windows_wstring_to_utf8(std::wstring_view wide_str, std::string& output);
+    static void windows_ansi_to_wstring(std::string_view ansi_str, std::wstring& output);
+    static void windows_wstring_to_ansi(std::wstring_view wide_str, std::string& output);
+    static void windows_utf8_to_ansi(std::string_view utf8_str, std::string& output);
+    static void windows_ansi_to_utf8(std::string_view ansi_str, std::string& output);
     
     // GB2312 相关函数
-    static std::wstring windows_gb2312_to_wstring(const std::string& gb2312_str);
-    static std::string windows_wstring_to_gb2312(const std::wstring& wide_str);
-    static std::string windows_gb2312_to_utf8(const std::string& gb2312_str);
-    static std::string windows_utf8_to_gb2312(const std::string& utf8_str);
-    static std::string windows_gb2312_to_ansi(const std::string& gb2312_str);
-    static std::string windows_ansi_to_gb2312(const std::string& ansi_str);
+    static void windows_gb2312_to_wstring(std::string_view gb2312_str, std::wstring& output);
+    static void windows_wstring_to_gb2312(std::wstring_view wide_str, std::string& output);
+    static void windows_gb2312_to_utf8(std::string_view gb2312_str, std::string& output);
+    static void windows_utf8_to_gb2312(std::string_view utf8_str, std::string& output);
+    static void windows_gb2312_to_ansi(std::string_view gb2312_str, std::string& output);
+    static void windows_ansi_to_gb2312(std::string_view ansi_str, std::string& output);
 #else
-    // 非 Windows 平台辅助函数
-    static std::wstring posix_utf8_to_wstring(const std::string& utf8_str);
-    static std::string posix_wstring_to_utf8(const std::wstring& wide_str);
-    static std::wstring posix_ansi_to_wstring(const std::string& ansi_str);
-    static std::string posix_wstring_to_ansi(const std::wstring& wide_str);
-    static std::string posix_utf8_to_ansi(const std::string& utf8_str);
-    static std::string posix_ansi_to_utf8(const std::string& ansi_str);
+    // 非 Windows 平台辅助函数，结果追加到 output 末尾
+    static void posix_utf8_to_wstring(std::string_view utf8_str, std::wstring& output);
+    static void posix_wstring_to_utf8(std::wstring_view wide_str, std::string& output);
+    static void posix_ansi_to_wstring(std::string_view ansi_str, std::wstring& output);
+    static void posix_wstring_to_ansi(std::wstring_view wide_str, std::string& output);
+    static void posix_utf8_to_ansi(std::string_view utf8_str, std::string& output);
+    static void posix_ansi_to_utf8(std::string_view ansi_str, std::string& output);
     
     // GB2312 相关函数
-    static std::wstring posix_gb2312_to_wstring(const std::string& gb2312_str);
-    static std::string posix_wstring_to_gb2312(const std::wstring& wide_str);
-    static std::string posix_gb2312_to_utf8(const std::string& gb2312_str);
-    static std::string posix_utf8_to_gb2312(const std::string& utf8_str);
-    static std::string posix_gb2312_to_ansi(const std::string& gb2312_str);
-    static std::string posix_ansi_to_gb2312(const std::string& ansi_str);
-
-    // 通用的 iconv 转换函数
+    static void posix_gb2312_to_wstring(std::string_view gb2312_str, std::wstring& output);
+    static void posix_wstring_to_gb2312(std::wstring_view wide_str, std::string& output);
+    static void posix_gb2312_to_utf8(std::string_view gb2312_str, std::string& output);
+    static void posix_utf8_to_gb2312(std::string_view utf8_str, std::string& output);
+    static void posix_gb2312_to_ansi(std::string_view gb2312_str, std::string& output);
+    static void posix_ansi_to_gb2312(std::string_view ansi_str, std::string& output);
+
+    // 内置转码器，返回转换状态而不抛出异常，结果追加到 output 末尾
+#ifdef STRING_CONVERTER_NATIVE_UTF32
+    static utf8_transcoder::Status native_utf8_to_wstring(std::string_view utf8_str, std::wstring& output);
+    static utf8_transcoder::Status native_wstring_to_utf8(std::wstring_view wide_str, std::string& output);
+#endif
+    static utf8_transcoder::Status native_gb2312_to_wstring(std::string_view gb2312_str, std::wstring& output);
+    static utf8_transcoder::Status native_wstring_to_gb2312(std::wstring_view wide_str, std::string& output);
+    static utf8_transcoder::Status native_gb2312_to_utf8(std::string_view gb2312_str, std::string& output);
+    static utf8_transcoder::Status native_utf8_to_gb2312(std::string_view utf8_str, std::string& output);
+
+    // 一个转换内核在当前线程上使用的 iconv 描述符。编码名称均来自生命周期内不变的字符串
+    // （字面量、检测结果或 set_ansi_encoding 固定下来的名称），因此按指针比较即可判断是否需要重新打开；
+    // 源编码与目标编码同名的判断也只在打开时做一次
+    struct IconvSlot {
+        const char* from = nullptr;
+        const char* to = nullptr;
+        iconv_t cd = (iconv_t)-1;
+        bool identity = false;
+
+        IconvSlot() = default;
+        IconvSlot(const IconvSlot&) = delete;
+        IconvSlot& operator=(const IconvSlot&) = delete;
+        ~IconvSlot() { close(); }
+
+        // 名称指针与上次相同时复用描述符并复位移位状态，否则重新打开；打开失败时返回 false，errno 为失败原因
+        bool bind(const char* from_encoding, const char* to_encoding);
+        void close();
+    };
+
+    // 通用的 iconv 转换函数，结果追加到 output 末尾；slot 为调用方（每个编码对一个）的线程局部描述符
     template<typename InputType, typename OutputType>
-    static OutputType posix_generic_convert(const InputType& input, const char* from_encoding, const char* to_encoding);
-    // 获取系统的 wchar_t 编码名称
+    static void posix_generic_convert(const InputType& input, IconvSlot& slot, const char* from_encoding, const char* to_encoding, OutputType& output);
+    // 获取系统的 wchar_t 编码名称，首次调用时检测一次
     static const char* get_wchar_encoding();
-    // 获取系统默认编码
-    static std::string get_system_encoding();
+    // 获取 ANSI 编码名称：优先使用 set_ansi_encoding 设置的编码，否则为首次调用时从环境变量检测的结果
+    static const char* get_system_encoding();
 #endif
 
-std::wstring StringConverter::utf8_to_wstring(const std::string& utf8_str) {
+// 各编码对的转换内核，在编译期选定；结果追加到 output 末尾，转换失败时抛出异常
+using Encoding = StringConverter::Encoding;
+
+template<Encoding From, Encoding To>
+struct ConversionKernel;
+
+// 源编码与目标编码相同：直接复制
+template<Encoding E>
+struct ConversionKernel<E, E> {
+    static void append(StringConverter::view_type<E> input, StringConverter::string_type<E>& output) {
+        output.append(input.data(), input.size());
+    }
+};
+
 #ifdef _WIN32
-    return safe_convert(utf8_str, windows_utf8_to_wstring);
+    #define PLATFORM_KERNEL(name) windows_##name
 #else
-    return safe_convert(utf8_str, posix_utf8_to_wstring);
+    #define PLATFORM_KERNEL(name) posix_##name
 #endif
+
+#define DEFINE_CONVERSION_KERNEL(from, to, name) \
+    template<> \
+    struct ConversionKernel<Encoding::from, Encoding::to> { \
+        static constexpr auto append = PLATFORM_KERNEL(name); \
+    };
+
+DEFINE_CONVERSION_KERNEL(UTF8, Wide, utf8_to_wstring)
+DEFINE_CONVERSION_KERNEL(Wide, UTF8, wstring_to_utf8)
+DEFINE_CONVERSION_KERNEL(ANSI, Wide, ansi_to_wstring)
+DEFINE_CONVERSION_KERNEL(Wide, ANSI, wstring_to_ansi)
+DEFINE_CONVERSION_KERNEL(UTF8, ANSI, utf8_to_ansi)
+DEFINE_CONVERSION_KERNEL(ANSI, UTF8, ansi_to_utf8)
+DEFINE_CONVERSION_KERNEL(GB2312, Wide, gb2312_to_wstring)
+DEFINE_CONVERSION_KERNEL(Wide, GB2312, wstring_to_gb2312)
+DEFINE_CONVERSION_KERNEL(GB2312, UTF8, gb2312_to_utf8)
+DEFINE_CONVERSION_KERNEL(UTF8, GB2312, utf8_to_gb2312)
+DEFINE_CONVERSION_KERNEL(GB2312, ANSI, gb2312_to_ansi)
+DEFINE_CONVERSION_KERNEL(ANSI, GB2312, ansi_to_gb2312)
+
+#undef DEFINE_CONVERSION_KERNEL
+#undef PLATFORM_KERNEL
+
+template<Encoding From, Encoding To>
+void StringConverter::append(view_type<From> input, string_type<To>& output) {
+    safe_append(input, output, ConversionKernel<From, To>::append);
 }
 
-std::string StringConverter::wstring_to_utf8(const std::wstring& wide_str) {
-#ifdef _WIN32
-    return safe_convert(wide_str, windows_wstring_to_utf8);
-#else
-    return safe_convert(wide_str, posix_wstring_to_utf8);
-#endif
+#define INSTANTIATE_APPEND(from, to) \
+    template void StringConverter::append<Encoding::from, Encoding::to>( \
+        StringConverter::view_type<Encoding::from>, StringConverter::string_type<Encoding::to>&);
+
+INSTANTIATE_APPEND(UTF8, UTF8)
+INSTANTIATE_APPEND(UTF8, GB2312)
+INSTANTIATE_APPEND(UTF8, ANSI)
+INSTANTIATE_APPEND(UTF8, Wide)
+INSTANTIATE_APPEND(GB2312, UTF8)
+INSTANTIATE_APPEND(GB2312, GB2312)
+INSTANTIATE_APPEND(GB2312, ANSI)
+INSTANTIATE_APPEND(GB2312, Wide)
+INSTANTIATE_APPEND(ANSI, UTF8)
+INSTANTIATE_APPEND(ANSI, GB2312)
+INSTANTIATE_APPEND(ANSI, ANSI)
+INSTANTIATE_APPEND(ANSI, Wide)
+INSTANTIATE_APPEND(Wide, UTF8)
+INSTANTIATE_APPEND(Wide, GB2312)
+INSTANTIATE_APPEND(Wide, ANSI)
+INSTANTIATE_APPEND(Wide, Wide)
+
+#undef INSTANTIATE_APPEND
+
+std::wstring StringConverter::utf8_to_wstring(std::string_view utf8_str) {
+    return convert<Encoding::UTF8, Encoding::Wide>(utf8_str);
 }
 
-std::wstring StringConverter::ansi_to_wstring(const std::string& ansi_str) {
-#ifdef _WIN32
-    return safe_convert(ansi_str, windows_ansi_to_wstring);
-#else
-    return safe_convert(ansi_str, posix_ansi_to_wstring);
-#endif
+void StringConverter::utf8_to_wstring(std::string_view utf8_str, std::wstring& output) {
+    convert<Encoding::UTF8, Encoding::Wide>(utf8_str, output);
 }
 
-std::string StringConverter::wstring_to_ansi(const std::wstring& wide_str) {
-#ifdef _WIN32
-    return safe_convert(wide_str, windows_wstring_to_ansi);
-#else
-    return safe_convert(wide_str, posix_wstring_to_ansi);
-#endif
+void StringConverter::append_utf8_to_wstring(std::string_view utf8_str, std::wstring& output) {
+    append<Encoding::UTF8, Encoding::Wide>(utf8_str, output);
 }
 
-std::string StringConverter::utf8_to_ansi(const std::string& utf8_str) {
-#ifdef _WIN32
-    return safe_convert(utf8_str, windows_utf8_to_ansi);
-#else
-    return safe_convert(utf8_str, posix_utf8_to_ansi);
-#endif
+std::wstring StringConverter::parallel_utf8_to_wstring(std::string_view utf8_str, unsigned int thread_count) {
+    return parallel_convert<std::wstring>(utf8_str, thread_count, utf8_chunk_boundary, utf8_to_wide_length,
+                                          utf8_to_wide_into, append_utf8_to_wstring);
 }
 
-std::string StringConverter::ansi_to_utf8(const std::string& ansi_str) {
-#ifdef _WIN32
-    return safe_convert(ansi_str, windows_ansi_to_utf8);
-#else
-    return safe_convert(ansi_str, posix_ansi_to_utf8);
-#endif
+std::string StringConverter::wstring_to_utf8(std::wstring_view wide_str) {
+    return convert<Encoding::Wide, Encoding::UTF8>(wide_str);
 }
 
-std::wstring StringConverter::gb2312_to_wstring(const std::string& gb2312_str) {
-#ifdef _WIN32
-    return safe_convert(gb2312_str, windows_gb2312_to_wstring);
+void StringConverter::wstring_to_utf8(std::wstring_view wide_str, std::string& output) {
+    convert<Encoding::Wide, Encoding::UTF8>(wide_str, output);
+}
+
+void StringConverter::append_wstring_to_utf8(std::wstring_view wide_str, std::string& output) {
+    append<Encoding::Wide, Encoding::UTF8>(wide_str, output);
+}
+
+std::wstring StringConverter::ansi_to_wstring(std::string_view ansi_str) {
+    return convert<Encoding::ANSI, Encoding::Wide>(ansi_str);
+}
+
+void StringConverter::ansi_to_wstring(std::string_view ansi_str, std::wstring& output) {
+    convert<Encoding::ANSI, Encoding::Wide>(ansi_str, output);
+}
+
+void StringConverter::append_ansi_to_wstring(std::string_view ansi_str, std::wstring& output) {
+    append<Encoding::ANSI, Encoding::Wide>(ansi_str, output);
+}
+
+std::string StringConverter::wstring_to_ansi(std::wstring_view wide_str) {
+    return convert<Encoding::Wide, Encoding::ANSI>(wide_str);
+}
+
+void StringConverter::wstring_to_ansi(std::wstring_view wide_str, std::string& output) {
+    convert<Encoding::Wide, Encoding::ANSI>(wide_str, output);
+}
+
+void StringConverter::append_wstring_to_ansi(std::wstring_view wide_str, std::string& output) {
+    append<Encoding::Wide, Encoding::ANSI>(wide_str, output);
+}
+
+std::string StringConverter::utf8_to_ansi(std::string_view utf8_str) {
+    return convert<Encoding::UTF8, Encoding::ANSI>(utf8_str);
+}
+
+void StringConverter::utf8_to_ansi(std::string_view utf8_str, std::string& output) {
+    convert<Encoding::UTF8, Encoding::ANSI>(utf8_str, output);
+}
+
+void StringConverter::append_utf8_to_ansi(std::string_view utf8_str, std::string& output) {
+    append<Encoding::UTF8, Encoding::ANSI>(utf8_str, output);
+}
+
+std::string StringConverter::ansi_to_utf8(std::string_view ansi_str) {
+    return convert<Encoding::ANSI, Encoding::UTF8>(ansi_str);
+}
+
+void StringConverter::ansi_to_utf8(std::string_view ansi_str, std::string& output) {
+    convert<Encoding::ANSI, Encoding::UTF8>(ansi_str, output);
+}
+
+void StringConverter::append_ansi_to_utf8(std::string_view ansi_str, std::string& output) {
+    append<Encoding::ANSI, Encoding::UTF8>(ansi_str, output);
+}
+
+std::wstring StringConverter::gb2312_to_wstring(std::string_view gb2312_str) {
+    return convert<Encoding::GB2312, Encoding::Wide>(gb2312_str);
+}
+
+void StringConverter::gb2312_to_wstring(std::string_view gb2312_str, std::wstring& output) {
+    convert<Encoding::GB2312, Encoding::Wide>(gb2312_str, output);
+}
+
+void StringConverter::append_gb2312_to_wstring(std::string_view gb2312_str, std::wstring& output) {
+    append<Encoding::GB2312, Encoding::Wide>(gb2312_str, output);
+}
+
+std::string StringConverter::wstring_to_gb2312(std::wstring_view wide_str) {
+    return convert<Encoding::Wide, Encoding::GB2312>(wide_str);
+}
+
+void StringConverter::wstring_to_gb2312(std::wstring_view wide_str, std::string& output) {
+    convert<Encoding::Wide, Encoding::GB2312>(wide_str, output);
+}
+
+void StringConverter::append_wstring_to_gb2312(std::wstring_view wide_str, std::string& output) {
+    append<Encoding::Wide, Encoding::GB2312>(wide_str, output);
+}
+
+std::string StringConverter::gb2312_to_utf8(std::string_view gb2312_str) {
+    return convert<Encoding::GB2312, Encoding::UTF8>(gb2312_str);
+}
+
+void StringConverter::gb2312_to_utf8(std::string_view gb2312_str, std::string& output) {
+    convert<Encoding::GB2312, Encoding::UTF8>(gb2312_str, output);
+}
+
+void StringConverter::append_gb2312_to_utf8(std::string_view gb2312_str, std::string& output) {
+    append<Encoding::GB2312, Encoding::UTF8>(gb2312_str, output);
+}
+
+std::string StringConverter::parallel_gb2312_to_utf8(std::string_view gb2312_str, unsigned int thread_count) {
+    return parallel_convert<std::string>(gb2312_str, thread_count, gb2312_chunk_boundary, gb2312_to_utf8_length,
+                                         gb2312_to_utf8_into, append_gb2312_to_utf8);
+}
+
+std::string StringConverter::utf8_to_gb2312(std::string_view utf8_str) {
+    return convert<Encoding::UTF8, Encoding::GB2312>(utf8_str);
+}
+
+void StringConverter::utf8_to_gb2312(std::string_view utf8_str, std::string& output) {
+    convert<Encoding::UTF8, Encoding::GB2312>(utf8_str, output);
+}
+
+void StringConverter::append_utf8_to_gb2312(std::string_view utf8_str, std::string& output) {
+    append<Encoding::UTF8, Encoding::GB2312>(utf8_str, output);
+}
+
+std::string StringConverter::gb2312_to_ansi(std::string_view gb2312_str) {
+    return convert<Encoding::GB2312, Encoding::ANSI>(gb2312_str);
+}
+
+void StringConverter::gb2312_to_ansi(std::string_view gb2312_str, std::string& output) {
+    convert<Encoding::GB2312, Encoding::ANSI>(gb2312_str, output);
+}
+
+void StringConverter::append_gb2312_to_ansi(std::string_view gb2312_str, std::string& output) {
+    append<Encoding::GB2312, Encoding::ANSI>(gb2312_str, output);
+}
+
+std::string StringConverter::ansi_to_gb2312(std::string_view ansi_str) {
+    return convert<Encoding::ANSI, Encoding::GB2312>(ansi_str);
+}
+
+void StringConverter::ansi_to_gb2312(std::string_view ansi_str, std::string& output) {
+    convert<Encoding::ANSI, Encoding::GB2312>(ansi_str, output);
+}
+
+void StringConverter::append_ansi_to_gb2312(std::string_view ansi_str, std::string& output) {
+    append<Encoding::ANSI, Encoding::GB2312>(ansi_str, output);
+}
+
+WStringBatch StringConverter::batch_utf8_to_wstring(StringSpan utf8_strs, unsigned int thread_count) {
+    return convert_batch<wchar_t>(utf8_strs, thread_count, append_utf8_to_wstring);
+}
+
+WStringBatch StringConverter::batch_gb2312_to_wstring(StringSpan gb2312_strs, unsigned int thread_count) {
+    return convert_batch<wchar_t>(gb2312_strs, thread_count, append_gb2312_to_wstring);
+}
+
+StringBatch StringConverter::batch_gb2312_to_utf8(StringSpan gb2312_strs, unsigned int thread_count) {
+    return convert_batch<char>(gb2312_strs, thread_count, append_gb2312_to_utf8);
+}
+
+StringBatch StringConverter::batch_utf8_to_gb2312(StringSpan utf8_strs, unsigned int thread_count) {
+    return convert_batch<char>(utf8_strs, thread_count, append_utf8_to_gb2312);
+}
+
+StringBatch StringConverter::batch_ansi_to_utf8(StringSpan ansi_strs, unsigned int thread_count) {
+    return convert_batch<char>(ansi_strs, thread_count, append_ansi_to_utf8);
+}
+
+StringBatch StringConverter::batch_utf8_to_ansi(StringSpan utf8_strs, unsigned int thread_count) {
+    return convert_batch<char>(utf8_strs, thread_count, append_utf8_to_ansi);
+}
+
+bool StringConverter::is_ascii(std::string_view str) noexcept {
+    return utf8_transcoder::ascii_prefix_length(str.data(), str.length()) == str.length();
+}
+
+bool StringConverter::is_valid_utf8(std::string_view str) noexcept {
+    return utf8_transcoder::is_valid(str.data(), str.length());
+}
+
+bool StringConverter::is_valid_gb2312(std::string_view str) noexcept {
+    return gbk_codec::is_valid_gbk(str.data(), str.length());
+}
+
+StringConverter::DetectedEncoding StringConverter::detect_encoding(std::string_view str) noexcept {
+    const size_t ascii = utf8_transcoder::ascii_prefix_length(str.data(), str.length());
+    if (ascii == str.length()) {
+        return DetectedEncoding::ASCII;
+    }
+    // ASCII 前缀在两种编码下都合法，只需检查剩余部分
+    const std::string_view rest = str.substr(ascii);
+    if (utf8_transcoder::is_valid(rest.data(), rest.length())) {
+        return DetectedEncoding::UTF8;
+    }
+    if (gbk_codec::is_valid_gbk(rest.data(), rest.length())) {
+        return DetectedEncoding::GB2312;
+    }
+    return DetectedEncoding::Unknown;
+}
+
+std::error_code StringConverter::try_utf8_to_wstring(std::string_view utf8_str, std::wstring& output) noexcept {
+#ifdef STRING_CONVERTER_NATIVE_UTF32
+    return try_convert(utf8_str, output, native_utf8_to_wstring);
 #else
-    return safe_convert(gb2312_str, posix_gb2312_to_wstring);
+    return try_convert(utf8_str, output, as_status_converter(append_utf8_to_wstring));
 #endif
 }
 
-std::string StringConverter::wstring_to_gb2312(const std::wstring& wide_str) {
-#ifdef _WIN32
-    return safe_convert(wide_str, windows_wstring_to_gb2312);
+std::error_code StringConverter::try_wstring_to_utf8(std::wstring_view wide_str, std::string& output) noexcept {
+#ifdef STRING_CONVERTER_NATIVE_UTF32
+    return try_convert(wide_str, output, native_wstring_to_utf8);
 #else
-    return safe_convert(wide_str, posix_wstring_to_gb2312);
+    return try_convert(wide_str, output, as_status_converter(append_wstring_to_utf8));
 #endif
 }
 
-std::string StringConverter::gb2312_to_utf8(const std::string& gb2312_str) {
+std::error_code StringConverter::try_gb2312_to_wstring(std::string_view gb2312_str, std::wstring& output) noexcept {
 #ifdef _WIN32
-    return safe_convert(gb2312_str, windows_gb2312_to_utf8);
+    return try_convert(gb2312_str, output, as_status_converter(append_gb2312_to_wstring));
 #else
-    return safe_convert(gb2312_str, posix_gb2312_to_utf8);
+    return try_convert(gb2312_str, output, native_gb2312_to_wstring);
 #endif
 }
 
-std::string StringConverter::utf8_to_gb2312(const std::string& utf8_str) {
+std::error_code StringConverter::try_wstring_to_gb2312(std::wstring_view wide_str, std::string& output) noexcept {
 #ifdef _WIN32
-    return safe_convert(utf8_str, windows_utf8_to_gb2312);
+    return try_convert(wide_str, output, as_status_converter(append_wstring_to_gb2312));
 #else
-    return safe_convert(utf8_str, posix_utf8_to_gb2312);
+    return try_convert(wide_str, output, native_wstring_to_gb2312);
 #endif
 }
 
-std::string StringConverter::gb2312_to_ansi(const std::string& gb2312_str) {
+std::error_code StringConverter::try_gb2312_to_utf8(std::string_view gb2312_str, std::string& output) noexcept {
 #ifdef _WIN32
-    return safe_convert(gb2312_str, windows_gb2312_to_ansi);
+    return try_convert(gb2312_str, output, as_status_converter(append_gb2312_to_utf8));
 #else
-    return safe_convert(gb2312_str, posix_gb2312_to_ansi);
+    return try_convert(gb2312_str, output, native_gb2312_to_utf8);
 #endif
 }
 
-std::string StringConverter::ansi_to_gb2312(const std::string& ansi_str) {
+std::error_code StringConverter::try_utf8_to_gb2312(std::string_view utf8_str, std::string& output) noexcept {
 #ifdef _WIN32
-    return safe_convert(ansi_str, windows_ansi_to_gb2312);
+    return try_convert(utf8_str, output, as_status_converter(append_utf8_to_gb2312));
 #else
-    return safe_convert(ansi_str, posix_ansi_to_gb2312);
+    return try_convert(utf8_str, output, native_utf8_to_gb2312);
 #endif
 }
 
 #ifdef _WIN32
 
 // Windows 平台统一多字节转宽字符函数
-static std::wstring windows_mb_to_wstring(const std::string& input, UINT codepage, const char* operation) {
+static void windows_mb_to_wstring(std::string_view input, UINT codepage, const char* operation, std::wstring& output) {
     int wide_length = MultiByteToWideChar(
-        codepage, 0, input.c_str(), 
+        codepage, 0, input.data(), 
         static_cast<int>(input.length()), nullptr, 0
     );
     
@@ -177,23 +798,22 @@ static std::wstring windows_mb_to_wstring(const std::string& input, UINT codepag
         throw std::runtime_error(std::string("Failed to convert to wide string (") + operation + "): MultiByteToWideChar failed");
     }
     
-    std::wstring wide_str(wide_length, L'\0');
+    const size_t base = output.size();
+    output.resize(base + wide_length);
     int result = MultiByteToWideChar(
-        codepage, 0, input.c_str(), 
-        static_cast<int>(input.length()), &wide_str[0], wide_length
+        codepage, 0, input.data(), 
+        static_cast<int>(input.length()), &output[base], wide_length
     );
     
     if (result <= 0) {
         throw std::runtime_error(std::string("Failed to convert to wide string (") + operation + "): conversion failed");
     }
-    
-    return wide_str;
 }
 
 // Windows 平台统一宽字符转多字节函数
-static std::string windows_wstring_to_mb(const std::wstring& input, UINT codepage, const char* operation) {
+static void windows_wstring_to_mb(std::wstring_view input, UINT codepage, const char* operation, std::string& output) {
     int mb_length = WideCharToMultiByte(
-        codepage, 0, input.c_str(), 
+        codepage, 0, input.data(), 
         static_cast<int>(input.length()), nullptr, 0, nullptr, nullptr
     );
     
@@ -201,286 +821,435 @@ static std::string windows_wstring_to_mb(const std::wstring& input, UINT codepag
         throw std::runtime_error(std::string("Failed to convert from wide string (") + operation + "): WideCharToMultiByte failed");
     }
     
-    std::string mb_str(mb_length, '\0');
+    const size_t base = output.size();
+    output.resize(base + mb_length);
     int result = WideCharToMultiByte(
-        codepage, 0, input.c_str(), 
-        static_cast<int>(input.length()), &mb_str[0], mb_length, nullptr, nullptr
+        codepage, 0, input.data(), 
+        static_cast<int>(input.length()), &output[base], mb_length, nullptr, nullptr
     );
     
     if (result <= 0) {
         throw std::runtime_error(std::string("Failed to convert from wide string (") + operation + "): conversion failed");
     }
-    
-    return mb_str;
 }
 
-static std::wstring windows_utf8_to_wstring(const std::string& utf8_str) {
-    return windows_mb_to_wstring(utf8_str, CP_UTF8, "UTF-8 to Unicode");
+static void windows_utf8_to_wstring(std::string_view utf8_str, std::wstring& output) {
+    windows_mb_to_wstring(utf8_str, CP_UTF8, "UTF-8 to Unicode", output);
 }
 
-static std::string windows_wstring_to_utf8(const std::wstring& wide_str) {
-    return windows_wstring_to_mb(wide_str, CP_UTF8, "Unicode to UTF-8");
+static void windows_wstring_to_utf8(std::wstring_view wide_str, std::string& output) {
+    windows_wstring_to_mb(wide_str, CP_UTF8, "Unicode to UTF-8", output);
 }
 
-static std::wstring windows_ansi_to_wstring(const std::string& ansi_str) {
-    return windows_mb_to_wstring(ansi_str, CP_ACP, "ANSI to Unicode");
+static void windows_ansi_to_wstring(std::string_view ansi_str, std::wstring& output) {
+    windows_mb_to_wstring(ansi_str, CP_ACP, "ANSI to Unicode", output);
 }
 
-static std::string windows_wstring_to_ansi(const std::wstring& wide_str) {
-    return windows_wstring_to_mb(wide_str, CP_ACP, "Unicode to ANSI");
+static void windows_wstring_to_ansi(std::wstring_view wide_str, std::string& output) {
+    windows_wstring_to_mb(wide_str, CP_ACP, "Unicode to ANSI", output);
 }
 
-static std::string windows_utf8_to_ansi(const std::string& utf8_str) {
+static void windows_utf8_to_ansi(std::string_view utf8_str, std::string& output) {
     // UTF-8 -> Unicode -> ANSI
-    std::wstring wide_str = windows_utf8_to_wstring(utf8_str);
-    return windows_wstring_to_ansi(wide_str);
+    std::wstring& wide_str = scratch_wstring();
+    windows_utf8_to_wstring(utf8_str, wide_str);
+    windows_wstring_to_ansi(wide_str, output);
 }
 
-static std::string windows_ansi_to_utf8(const std::string& ansi_str) {
+static void windows_ansi_to_utf8(std::string_view ansi_str, std::string& output) {
     // ANSI -> Unicode -> UTF-8
-    std::wstring wide_str = windows_ansi_to_wstring(ansi_str);
-    return windows_wstring_to_utf8(wide_str);
+    std::wstring& wide_str = scratch_wstring();
+    windows_ansi_to_wstring(ansi_str, wide_str);
+    windows_wstring_to_utf8(wide_str, output);
 }
 
 // GB2312 相关实现
-static std::wstring windows_gb2312_to_wstring(const std::string& gb2312_str) {
-    return windows_mb_to_wstring(gb2312_str, 936, "GB2312 to Unicode");
+static void windows_gb2312_to_wstring(std::string_view gb2312_str, std::wstring& output) {
+    windows_mb_to_wstring(gb2312_str, 936, "GB2312 to Unicode", output);
 }
 
-static std::string windows_wstring_to_gb2312(const std::wstring& wide_str) {
-    return windows_wstring_to_mb(wide_str, 936, "Unicode to GB2312");
+static void windows_wstring_to_gb2312(std::wstring_view wide_str, std::string& output) {
+    windows_wstring_to_mb(wide_str, 936, "Unicode to GB2312", output);
 }
 
-static std::string windows_gb2312_to_utf8(const std::string& gb2312_str) {
+static void windows_gb2312_to_utf8(std::string_view gb2312_str, std::string& output) {
     // GB2312 -> Unicode -> UTF-8
-    std::wstring wide_str = windows_gb2312_to_wstring(gb2312_str);
-    return windows_wstring_to_utf8(wide_str);
+    std::wstring& wide_str = scratch_wstring();
+    windows_gb2312_to_wstring(gb2312_str, wide_str);
+    windows_wstring_to_utf8(wide_str, output);
 }
 
-static std::string windows_utf8_to_gb2312(const std::string& utf8_str) {
+static void windows_utf8_to_gb2312(std::string_view utf8_str, std::string& output) {
     // UTF-8 -> Unicode -> GB2312
-    std::wstring wide_str = windows_utf8_to_wstring(utf8_str);
-    return windows_wstring_to_gb2312(wide_str);
+    std::wstring& wide_str = scratch_wstring();
+    windows_utf8_to_wstring(utf8_str, wide_str);
+    windows_wstring_to_gb2312(wide_str, output);
 }
 
-static std::string windows_gb2312_to_ansi(const std::string& gb2312_str) {
+static void windows_gb2312_to_ansi(std::string_view gb2312_str, std::string& output) {
     // GB2312 -> Unicode -> ANSI
-    std::wstring wide_str = windows_gb2312_to_wstring(gb2312_str);
-    return windows_wstring_to_ansi(wide_str);
+    std::wstring& wide_str = scratch_wstring();
+    windows_gb2312_to_wstring(gb2312_str, wide_str);
+    windows_wstring_to_ansi(wide_str, output);
 }
 
-static std::string windows_ansi_to_gb2312(const std::string& ansi_str) {
+static void windows_ansi_to_gb2312(std::string_view ansi_str, std::string& output) {
     // ANSI -> Unicode -> GB2312
-    std::wstring wide_str = windows_ansi_to_wstring(ansi_str);
-    return windows_wstring_to_gb2312(wide_str);
+    std::wstring& wide_str = scratch_wstring();
+    windows_ansi_to_wstring(ansi_str, wide_str);
+    windows_wstring_to_gb2312(wide_str, output);
 }
 
 #else // 非 Windows 平台
 
-static std::wstring posix_utf8_to_wstring(const std::string& utf8_str) {
-    return posix_generic_convert<std::string, std::wstring>(utf8_str, "UTF-8", get_wchar_encoding());
+// 内置转码器的错误信息与 iconv 路径保持一致
+[[noreturn]] static void throw_native_error(utf8_transcoder::Status status, const char* from_encoding, const char* to_encoding) {
+    int error_code = (status == utf8_transcoder::Status::incomplete) ? EINVAL : EILSEQ;
+    throw std::runtime_error("Failed to convert from " + std::string(from_encoding) + 
+                            " to " + std::string(to_encoding) + ": " + std::string(strerror(error_code)));
+}
+
+#ifdef STRING_CONVERTER_NATIVE_UTF32
+
+// wchar_t 为 UTF-32 时 UTF-8 <-> wchar_t 是纯算术转换，不经过 iconv
+static utf8_transcoder::Status native_utf8_to_wstring(std::string_view utf8_str, std::wstring& output) {
+    const size_t base = output.size();
+    output.resize(base + utf8_str.length());
+    utf8_transcoder::Result result = utf8_transcoder::utf8_to_wide(utf8_str.data(), utf8_str.length(), &output[base]);
+    output.resize(base + result.written);
+    return result.status;
+}
+
+static utf8_transcoder::Status native_wstring_to_utf8(std::wstring_view wide_str, std::string& output) {
+    utf8_transcoder::Result result = utf8_transcoder::wide_to_utf8_length(wide_str.data(), wide_str.length());
+    if (result.status != utf8_transcoder::Status::ok) {
+        return result.status;
+    }
+    const size_t base = output.size();
+    output.resize(base + result.written);
+    utf8_transcoder::wide_to_utf8(wide_str.data(), wide_str.length(), &output[base]);
+    return utf8_transcoder::Status::ok;
+}
+
+static void posix_utf8_to_wstring(std::string_view utf8_str, std::wstring& output) {
+    utf8_transcoder::Status status = native_utf8_to_wstring(utf8_str, output);
+    if (status != utf8_transcoder::Status::ok) {
+        throw_native_error(status, "UTF-8", get_wchar_encoding());
+    }
+}
+
+static void posix_wstring_to_utf8(std::wstring_view wide_str, std::string& output) {
+    utf8_transcoder::Status status = native_wstring_to_utf8(wide_str, output);
+    if (status != utf8_transcoder::Status::ok) {
+        throw_native_error(status, get_wchar_encoding(), "UTF-8");
+    }
+}
+
+#else
+
+static void posix_utf8_to_wstring(std::string_view utf8_str, std::wstring& output) {
+    static thread_local IconvSlot slot;
+    posix_generic_convert(utf8_str, slot, "UTF-8", get_wchar_encoding(), output);
 }
 
-static std::string posix_wstring_to_utf8(const std::wstring& wide_str) {
-    return posix_generic_convert<std::wstring, std::string>(wide_str, get_wchar_encoding(), "UTF-8");
+static void posix_wstring_to_utf8(std::wstring_view wide_str, std::string& output) {
+    static thread_local IconvSlot slot;
+    posix_generic_convert(wide_str, slot, get_wchar_encoding(), "UTF-8", output);
 }
 
-static std::wstring posix_ansi_to_wstring(const std::string& ansi_str) {
-    std::string system_encoding = get_system_encoding();
-    return posix_generic_convert<std::string, std::wstring>(ansi_str, system_encoding.c_str(), get_wchar_encoding());
+#endif
+
+static void posix_ansi_to_wstring(std::string_view ansi_str, std::wstring& output) {
+    static thread_local IconvSlot slot;
+    posix_generic_convert(ansi_str, slot, get_system_encoding(), get_wchar_encoding(), output);
 }
 
-static std::string posix_wstring_to_ansi(const std::wstring& wide_str) {
-    std::string system_encoding = get_system_encoding();
-    return posix_generic_convert<std::wstring, std::string>(wide_str, get_wchar_encoding(), system_encoding.c_str());
+static void posix_wstring_to_ansi(std::wstring_view wide_str, std::string& output) {
+    static thread_local IconvSlot slot;
+    posix_generic_convert(wide_str, slot, get_wchar_encoding(), get_system_encoding(), output);
 }
 
-static std::string posix_utf8_to_ansi(const std::string& utf8_str) {
-    std::string system_encoding = get_system_encoding();
-    return posix_generic_convert<std::string, std::string>(utf8_str, "UTF-8", system_encoding.c_str());
+static void posix_utf8_to_ansi(std::string_view utf8_str, std::string& output) {
+    static thread_local IconvSlot slot;
+    posix_generic_convert(utf8_str, slot, "UTF-8", get_system_encoding(), output);
 }
 
-static std::string posix_ansi_to_utf8(const std::string& ansi_str) {
-    std::string system_encoding = get_system_encoding();
-    return posix_generic_convert<std::string, std::string>(ansi_str, system_encoding.c_str(), "UTF-8");
+static void posix_ansi_to_utf8(std::string_view ansi_str, std::string& output) {
+    static thread_local IconvSlot slot;
+    posix_generic_convert(ansi_str, slot, get_system_encoding(), "UTF-8", output);
 }
 
 // GB2312 相关实现
-static std::wstring posix_gb2312_to_wstring(const std::string& gb2312_str) {
-    return posix_generic_convert<std::string, std::wstring>(gb2312_str, "GB2312", get_wchar_encoding());
+// 使用内置的代码页 936（GBK）码表，与 Windows 的 936 代码页结果一致，不依赖 iconv
+static utf8_transcoder::Status native_gb2312_to_wstring(std::string_view gb2312_str, std::wstring& output) {
+    return gbk_codec::append_gbk_to_wide(gb2312_str.data(), gb2312_str.length(), output).status;
+}
+
+static utf8_transcoder::Status native_wstring_to_gb2312(std::wstring_view wide_str, std::string& output) {
+    return gbk_codec::append_wide_to_gbk(wide_str.data(), wide_str.length(), output).status;
+}
+
+static utf8_transcoder::Status native_gb2312_to_utf8(std::string_view gb2312_str, std::string& output) {
+    return gbk_codec::append_gbk_to_utf8(gb2312_str.data(), gb2312_str.length(), output).status;
+}
+
+static utf8_transcoder::Status native_utf8_to_gb2312(std::string_view utf8_str, std::string& output) {
+    return gbk_codec::append_utf8_to_gbk(utf8_str.data(), utf8_str.length(), output).status;
+}
+
+static void posix_gb2312_to_wstring(std::string_view gb2312_str, std::wstring& output) {
+    utf8_transcoder::Status status = native_gb2312_to_wstring(gb2312_str, output);
+    if (status != utf8_transcoder::Status::ok) {
+        throw_native_error(status, "GB2312", get_wchar_encoding());
+    }
+}
+
+static void posix_wstring_to_gb2312(std::wstring_view wide_str, std::string& output) {
+    utf8_transcoder::Status status = native_wstring_to_gb2312(wide_str, output);
+    if (status != utf8_transcoder::Status::ok) {
+        throw_native_error(status, get_wchar_encoding(), "GB2312");
+    }
+}
+
+static void posix_gb2312_to_utf8(std::string_view gb2312_str, std::string& output) {
+    utf8_transcoder::Status status = native_gb2312_to_utf8(gb2312_str, output);
+    if (status != utf8_transcoder::Status::ok) {
+        throw_native_error(status, "GB2312", "UTF-8");
+    }
 }
 
-static std::string posix_wstring_to_gb2312(const std::wstring& wide_str) {
-    return posix_generic_convert<std::wstring, std::string>(wide_str, get_wchar_encoding(), "GB2312");
+static void posix_utf8_to_gb2312(std::string_view utf8_str, std::string& output) {
+    utf8_transcoder::Status status = native_utf8_to_gb2312(utf8_str, output);
+    if (status != utf8_transcoder::Status::ok) {
+        throw_native_error(status, "UTF-8", "GB2312");
+    }
 }
 
-static std::string posix_gb2312_to_utf8(const std::string& gb2312_str) {
-    return posix_generic_convert<std::string, std::string>(gb2312_str, "GB2312", "UTF-8");
+static void posix_gb2312_to_ansi(std::string_view gb2312_str, std::string& output) {
+    // GB2312 -> Unicode -> ANSI
+    std::wstring& wide_str = scratch_wstring();
+    posix_gb2312_to_wstring(gb2312_str, wide_str);
+    posix_wstring_to_ansi(wide_str, output);
 }
 
-static std::string posix_utf8_to_gb2312(const std::string& utf8_str) {
-    return posix_generic_convert<std::string, std::string>(utf8_str, "UTF-8", "GB2312");
+static void posix_ansi_to_gb2312(std::string_view ansi_str, std::string& output) {
+    // ANSI -> Unicode -> GB2312
+    std::wstring& wide_str = scratch_wstring();
+    posix_ansi_to_wstring(ansi_str, wide_str);
+    posix_wstring_to_gb2312(wide_str, output);
 }
 
-static std::string posix_gb2312_to_ansi(const std::string& gb2312_str) {
-    std::string system_encoding = get_system_encoding();
-    return posix_generic_convert<std::string, std::string>(gb2312_str, "GB2312", system_encoding.c_str());
+bool IconvSlot::bind(const char* from_encoding, const char* to_encoding) {
+    if (cd != (iconv_t)-1 && from == from_encoding && to == to_encoding) {
+        // 复位转换状态，丢弃上一次（可能失败的）转换残留的移位状态
+        iconv(cd, nullptr, nullptr, nullptr, nullptr);
+        return true;
+    }
+    close();
+    cd = iconv_open(to_encoding, from_encoding);
+    if (cd == (iconv_t)-1) {
+        return false;
+    }
+    from = from_encoding;
+    to = to_encoding;
+    identity = strcmp(from_encoding, to_encoding) == 0;
+    return true;
 }
 
-static std::string posix_ansi_to_gb2312(const std::string& ansi_str) {
-    std::string system_encoding = get_system_encoding();
-    return posix_generic_convert<std::string, std::string>(ansi_str, system_encoding.c_str(), "GB2312");
+void IconvSlot::close() {
+    if (cd != (iconv_t)-1) {
+        iconv_close(cd);
+    }
+    cd = (iconv_t)-1;
+    from = to = nullptr;
 }
 
 template<typename InputType, typename OutputType>
-static OutputType posix_generic_convert(const InputType& input,
-                                       const char* from_encoding,
-                                       const char* to_encoding) {
+static void posix_generic_convert(const InputType& input,
+                                  IconvSlot& slot,
+                                  const char* from_encoding,
+                                  const char* to_encoding,
+                                  OutputType& output) {
     if (input.empty()) {
-        return OutputType();
+        return;
     }
     
-    // 如果源编码和目标编码相同，且类型相同，直接返回
-    if constexpr (std::is_same<InputType, OutputType>::value) {
-        if (strcmp(from_encoding, to_encoding) == 0) {
-            return input;
-        }
-    }
-    
-    iconv_t cd = iconv_open(to_encoding, from_encoding);
-    if (cd == (iconv_t)-1) {
+    if (!slot.bind(from_encoding, to_encoding)) {
         throw std::runtime_error("Failed to open iconv from " + std::string(from_encoding) + 
                                 " to " + std::string(to_encoding) + ": " + std::string(strerror(errno)));
     }
     
+    // 如果源编码和目标编码相同，且字符类型相同，直接追加
+    if constexpr (std::is_same<typename InputType::value_type, typename OutputType::value_type>::value) {
+        if (slot.identity) {
+            output.append(input);
+            return;
+        }
+    }
+    iconv_t cd = slot.cd;
+    
     // 准备输入缓冲区
-    size_t in_bytes_left;
-    char* in_buf;
+    using InputChar = typename InputType::value_type;
+    using OutputChar = typename OutputType::value_type;
+    size_t in_bytes_left = input.length() * sizeof(InputChar);
+    char* in_buf = reinterpret_cast<char*>(const_cast<InputChar*>(input.data()));
     
-    if constexpr (std::is_same<InputType, std::string>::value) {
-        in_bytes_left = input.length();
-        in_buf = const_cast<char*>(input.c_str());
-    } else { // std::wstring
-        in_bytes_left = input.length() * sizeof(wchar_t);
-        in_buf = reinterpret_cast<char*>(const_cast<wchar_t*>(input.c_str()));
-    }
+    // 直接写入输出字符串末尾：初始按每个输入字符产生一个输出字符估计，
+    // iconv 返回 E2BIG 时再扩容，峰值内存接近实际输出大小
+    const size_t base_bytes = output.size() * sizeof(OutputChar);
+    size_t used_bytes = base_bytes;
+    output.resize(output.size() + input.length());
     
-    // 准备输出缓冲区
-    size_t out_buf_size;
-    if constexpr (std::is_same<OutputType, std::string>::value) {
-        out_buf_size = input.length() * 4; // 足够大的缓冲区
-    } else { // std::wstring
-        out_buf_size = input.length() * sizeof(wchar_t) * 2; // 足够大的缓冲区
+    // 执行转换，最后一轮以空输入刷新移位状态
+    bool flushing = false;
+    for (;;) {
+        size_t capacity_bytes = output.size() * sizeof(OutputChar);
+        char* out_buf = reinterpret_cast<char*>(&output[0]) + used_bytes;
+        size_t out_bytes_left = capacity_bytes - used_bytes;
+        
+        size_t result = flushing
+            ? iconv(cd, nullptr, nullptr, &out_buf, &out_bytes_left)
+            : iconv(cd, &in_buf, &in_bytes_left, &out_buf, &out_bytes_left);
+        int error_code = errno;
+        used_bytes = capacity_bytes - out_bytes_left;
+        
+        if (result != (size_t)-1) {
+            if (flushing) {
+                break;
+            }
+            flushing = true;
+            continue;
+        }
+        if (error_code != E2BIG) {
+            throw std::runtime_error("Failed to convert from " + std::string(from_encoding) + 
+                                    " to " + std::string(to_encoding) + ": " + std::string(strerror(error_code)));
+        }
+        
+        // 按已转换部分的膨胀比例估算剩余输出，至少留出一个多字节序列的空间
+        size_t consumed = input.length() * sizeof(InputChar) - in_bytes_left;
+        size_t produced = used_bytes - base_bytes;
+        size_t grow = consumed > 0
+            ? static_cast<size_t>(static_cast<double>(produced) / consumed * in_bytes_left) / sizeof(OutputChar)
+            : output.size();
+        output.resize(output.size() + std::max<size_t>(grow, 8));
     }
     
-    size_t out_bytes_left = out_buf_size;
-    std::vector<char> temp_output(out_buf_size);
-    char* out_buf = temp_output.data();
+    output.resize(used_bytes / sizeof(OutputChar));
+}
+
+static const char* detect_wchar_encoding() {
+    // 确定字节序
+    union {
+        uint32_t i;
+        char c[4];
+    } test = { 0x01020304 };
     
-    // 执行转换
-    size_t result = iconv(cd, &in_buf, &in_bytes_left, &out_buf, &out_bytes_left);
+    bool is_big_endian = (test.c[0] == 0x01);
     
-    if (result == (size_t)-1) {
-        int error_code = errno;
-        iconv_close(cd);
-        throw std::runtime_error("Failed to convert from " + std::string(from_encoding) + 
-                                " to " + std::string(to_encoding) + ": " + std::string(strerror(error_code)));
+    // 根据wchar_t的大小和字节序确定编码
+    if (sizeof(wchar_t) == 4) {
+        return is_big_endian ? "UTF-32BE" : "UTF-32LE";
+    }
+    if (sizeof(wchar_t) == 2) {
+        return is_big_endian ? "UTF-16BE" : "UTF-16LE";
     }
     
-    iconv_close(cd);
-    
-    // 构造输出
-    size_t converted_bytes = out_buf_size - out_bytes_left;
+    // 后备选项，尝试常见的编码名称
+    static const char* candidates[] = {
+        "WCHAR_T", "UCS-4", "UTF-32", "UCS-2", "UTF-16", nullptr
+    };
     
-    if constexpr (std::is_same<OutputType, std::string>::value) {
-        return std::string(temp_output.data(), converted_bytes);
-    } else { // std::wstring
-        size_t wchar_count = converted_bytes / sizeof(wchar_t);
-        return std::wstring(reinterpret_cast<wchar_t*>(temp_output.data()), wchar_count);
+    // 测试哪个编码名称可用
+    for (int i = 0; candidates[i] != nullptr; ++i) {
+        iconv_t cd = iconv_open("UTF-8", candidates[i]);
+        if (cd != (iconv_t)-1) {
+            iconv_close(cd);
+            return candidates[i];
+        }
     }
+    
+    // 如果都不行，使用UTF-32LE作为默认值
+    return is_big_endian ? "UTF-32BE" : "UTF-32LE";
 }
 
 static const char* get_wchar_encoding() {
-    static const char* wchar_encoding = nullptr;
-    if (wchar_encoding == nullptr) {
-        // 确定字节序
-        union {
-            uint32_t i;
-            char c[4];
-        } test = { 0x01020304 };
-        
-        bool is_big_endian = (test.c[0] == 0x01);
-        
-        // 根据wchar_t的大小和字节序确定编码
-        if (sizeof(wchar_t) == 4) {
-            wchar_encoding = is_big_endian ? "UTF-32BE" : "UTF-32LE";
-        } else if (sizeof(wchar_t) == 2) {
-            wchar_encoding = is_big_endian ? "UTF-16BE" : "UTF-16LE";
-        } else {
-            // 后备选项，尝试常见的编码名称
-            static const char* candidates[] = {
-                "WCHAR_T", "UCS-4", "UTF-32", "UCS-2", "UTF-16", nullptr
-            };
-            
-            // 测试哪个编码名称可用
-            for (int i = 0; candidates[i] != nullptr; ++i) {
-                iconv_t cd = iconv_open("UTF-8", candidates[i]);
-                if (cd != (iconv_t)-1) {
-                    iconv_close(cd);
-                    wchar_encoding = candidates[i];
-                    break;
-                }
-            }
-            
-            // 如果都不行，使用UTF-32LE作为默认值
-            if (wchar_encoding == nullptr) {
-                wchar_encoding = is_big_endian ? "UTF-32BE" : "UTF-32LE";
-            }
-        }
-    }
+    // 函数内静态变量的初始化是线程安全的
+    static const char* const wchar_encoding = detect_wchar_encoding();
     return wchar_encoding;
 }
 
-static std::string get_system_encoding() {
+// 从形如 "zh_CN.GBK@modifier" 的 locale 名称中取出编码部分
+static std::string parse_locale_encoding(const char* locale_name) {
+    if (locale_name == nullptr) {
+        return std::string();
+    }
+    const char* dot = std::strchr(locale_name, '.');
+    if (dot == nullptr) {
+        return std::string();
+    }
+    const char* encoding = dot + 1;
+    return std::string(encoding, std::strcspn(encoding, "@"));
+}
+
+static std::string detect_system_encoding() {
     // 获取系统默认编码
-    const char* lang = std::getenv("LANG");
-    if (lang) {
-        std::string lang_str(lang);
-        size_t dot_pos = lang_str.find('.');
-        if (dot_pos != std::string::npos) {
-            std::string encoding = lang_str.substr(dot_pos + 1);
-            size_t at_pos = encoding.find('@');
-            if (at_pos != std::string::npos) {
-                encoding = encoding.substr(0, at_pos);
-            }
-            if (!encoding.empty()) {
-                return encoding;
-            }
-        }
+    std::string encoding = parse_locale_encoding(std::getenv("LANG"));
+    if (!encoding.empty()) {
+        return encoding;
     }
     
     // 检查 LC_CTYPE
-    const char* lc_ctype = std::getenv("LC_CTYPE");
-    if (lc_ctype) {
-        std::string lc_str(lc_ctype);
-        size_t dot_pos = lc_str.find('.');
-        if (dot_pos != std::string::npos) {
-            std::string encoding = lc_str.substr(dot_pos + 1);
-            size_t at_pos = encoding.find('@');
-            if (at_pos != std::string::npos) {
-                encoding = encoding.substr(0, at_pos);
-            }
-            if (!encoding.empty()) {
-                return encoding;
-            }
-        }
+    encoding = parse_locale_encoding(std::getenv("LC_CTYPE"));
+    if (!encoding.empty()) {
+        return encoding;
     }
     
     // 默认编码
     return "UTF-8";
 }
 
+// set_ansi_encoding 设置的编码，nullptr 表示使用检测结果。
+// 指向的字符串保存在 pinned_encodings 中且从不释放，其它线程读到旧指针时仍然有效
+static std::atomic<const std::string*> pinned_ansi_encoding{nullptr};
+static std::mutex pinned_encodings_mutex;
+static std::deque<std::string> pinned_encodings;
+
+static const char* get_system_encoding() {
+    const std::string* pinned = pinned_ansi_encoding.load(std::memory_order_acquire);
+    if (pinned != nullptr) {
+        return pinned->c_str();
+    }
+    static const std::string detected = detect_system_encoding();
+    return detected.c_str();
+}
+
+#endif
+
+void StringConverter::set_ansi_encoding(std::string_view encoding) {
+#ifdef _WIN32
+    // Windows 平台的 ANSI 转换始终使用系统代码页
+    (void)encoding;
+#else
+    if (encoding.empty()) {
+        pinned_ansi_encoding.store(nullptr, std::memory_order_release);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(pinned_encodings_mutex);
+    auto it = std::find(pinned_encodings.begin(), pinned_encodings.end(), encoding);
+    if (it == pinned_encodings.end()) {
+        const std::string name(encoding);
+        iconv_t cd = iconv_open("UTF-8", name.c_str());
+        if (cd == (iconv_t)-1) {
+            throw std::runtime_error("Unsupported ANSI encoding: " + name);
+        }
+        iconv_close(cd);
+        pinned_encodings.push_back(name);
+        it = std::prev(pinned_encodings.end());
+    }
+    pinned_ansi_encoding.store(&*it, std::memory_order_release);
 #endif
+}
 
 // 获取当前系统的 ANSI 代码页
 unsigned int StringConverter::get_ansi_codepage() {
@@ -489,4 +1258,13 @@ unsigned int StringConverter::get_ansi_codepage() {
 #else
     return 0; // 非 Windows 系统返回 0
 #endif
-}
\ No newline at end of file
+}
+
+// 获取 ANSI 转换当前使用的编码名称
+std::string StringConverter::get_ansi_encoding() {
+#ifdef _WIN32
+    return "CP" + std::to_string(GetACP());
+#else
+    return get_system_encoding();
+#endif
+}
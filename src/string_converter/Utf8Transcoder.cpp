@@ -0,0 +1,522 @@
+#include "Utf8Transcoder.hpp"
+
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define UTF8_TRANSCODER_X86 1
+    #include <immintrin.h>
+#endif
+
+namespace utf8_transcoder {
+
+namespace {
+
+// ASCII 快速路径内核：按块处理，遇到含非 ASCII 字符的块即停止，返回已处理的单元数
+using WidenAsciiFn = size_t (*)(const unsigned char* input, size_t length, wchar_t* output);
+using NarrowAsciiFn = size_t (*)(const wchar_t* input, size_t length, char* output);
+using SpanAsciiFn = size_t (*)(const wchar_t* input, size_t length);
+using ScanAsciiFn = size_t (*)(const unsigned char* input, size_t length);
+// UTF-8 校验内核：校验整个输入，返回是否合法
+using ValidateFn = bool (*)(const unsigned char* input, size_t length);
+
+struct Kernels {
+    WidenAsciiFn widen;
+    NarrowAsciiFn narrow;
+    SpanAsciiFn span;
+    ScanAsciiFn scan;
+    ValidateFn validate;
+};
+
+// 标量版本不做块处理，由调用方逐字符处理
+size_t widen_ascii_scalar(const unsigned char*, size_t, wchar_t*) { return 0; }
+size_t narrow_ascii_scalar(const wchar_t*, size_t, char*) { return 0; }
+size_t span_ascii_scalar(const wchar_t*, size_t) { return 0; }
+
+// 每次检查 8 个字节的最高位
+size_t scan_ascii_scalar(const unsigned char* input, size_t length) {
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, input + i, sizeof(word));
+        if ((word & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+    }
+    return i;
+}
+
+// 逐字符校验，ASCII 段仍按块跳过
+bool validate_utf8_scalar(const unsigned char* input, size_t length) {
+    size_t i = 0;
+    while (i < length) {
+        i += ascii_prefix_length(reinterpret_cast<const char*>(input + i), length - i);
+        if (i == length) {
+            break;
+        }
+        uint32_t code_point = 0;
+        size_t size = 0;
+        if (decode_sequence(input + i, length - i, code_point, size) != Status::ok) {
+            return false;
+        }
+        i += size;
+    }
+    return true;
+}
+
+#ifdef UTF8_TRANSCODER_X86
+
+// SSE2：每步 16 字节
+__attribute__((target("sse2")))
+size_t widen_ascii_sse2(const unsigned char* input, size_t length, wchar_t* output) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        if (_mm_movemask_epi8(bytes) != 0) {
+            break;
+        }
+        __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+        __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+        __m128i* out = reinterpret_cast<__m128i*>(output + i);
+        _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+    }
+    return i;
+}
+
+__attribute__((target("sse2")))
+size_t scan_ascii_sse2(const unsigned char* input, size_t length) {
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        if (_mm_movemask_epi8(bytes) != 0) {
+            break;
+        }
+    }
+    return i;
+}
+
+// 判断 4 组 32 位码点是否全部小于 0x80
+__attribute__((target("sse2")))
+inline bool all_ascii_sse2(__m128i a, __m128i b, __m128i c, __m128i d) {
+    __m128i bits = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+    __m128i high = _mm_and_si128(bits, _mm_set1_epi32(~0x7F));
+    return _mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) == 0xFFFF;
+}
+
+__attribute__((target("sse2")))
+size_t narrow_ascii_sse2(const wchar_t* input, size_t length, char* output) {
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        const __m128i* in = reinterpret_cast<const __m128i*>(input + i);
+        __m128i a = _mm_loadu_si128(in + 0);
+        __m128i b = _mm_loadu_si128(in + 1);
+        __m128i c = _mm_loadu_si128(in + 2);
+        __m128i d = _mm_loadu_si128(in + 3);
+        if (!all_ascii_sse2(a, b, c, d)) {
+            break;
+        }
+        __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), bytes);
+    }
+    return i;
+}
+
+__attribute__((target("sse2")))
+size_t span_ascii_sse2(const wchar_t* input, size_t length) {
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        const __m128i* in = reinterpret_cast<const __m128i*>(input + i);
+        if (!all_ascii_sse2(_mm_loadu_si128(in + 0), _mm_loadu_si128(in + 1),
+                            _mm_loadu_si128(in + 2), _mm_loadu_si128(in + 3))) {
+            break;
+        }
+    }
+    return i;
+}
+
+// AVX2：每步 32 字节
+__attribute__((target("avx2")))
+size_t widen_ascii_avx2(const unsigned char* input, size_t length, wchar_t* output) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        if (_mm256_movemask_epi8(bytes) != 0) {
+            break;
+        }
+        __m256i* out = reinterpret_cast<__m256i*>(output + i);
+        for (int k = 0; k < 4; ++k) {
+            __m128i eight = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i + 8 * k));
+            _mm256_storeu_si256(out + k, _mm256_cvtepu8_epi32(eight));
+        }
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+size_t scan_ascii_avx2(const unsigned char* input, size_t length) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        if (_mm256_movemask_epi8(bytes) != 0) {
+            break;
+        }
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline bool all_ascii_avx2(__m256i a, __m256i b, __m256i c, __m256i d) {
+    __m256i bits = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+    return _mm256_testz_si256(bits, _mm256_set1_epi32(~0x7F)) != 0;
+}
+
+__attribute__((target("avx2")))
+size_t narrow_ascii_avx2(const wchar_t* input, size_t length, char* output) {
+    // packus 在 128 位通道内交错，最后按 32 位重排恢复顺序
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        const __m256i* in = reinterpret_cast<const __m256i*>(input + i);
+        __m256i a = _mm256_loadu_si256(in + 0);
+        __m256i b = _mm256_loadu_si256(in + 1);
+        __m256i c = _mm256_loadu_si256(in + 2);
+        __m256i d = _mm256_loadu_si256(in + 3);
+        if (!all_ascii_avx2(a, b, c, d)) {
+            break;
+        }
+        __m256i bytes = _mm256_packus_epi16(_mm256_packus_epi32(a, b), _mm256_packus_epi32(c, d));
+        bytes = _mm256_permutevar8x32_epi32(bytes, order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), bytes);
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+size_t span_ascii_avx2(const wchar_t* input, size_t length) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        const __m256i* in = reinterpret_cast<const __m256i*>(input + i);
+        if (!all_ascii_avx2(_mm256_loadu_si256(in + 0), _mm256_loadu_si256(in + 1),
+                            _mm256_loadu_si256(in + 2), _mm256_loadu_si256(in + 3))) {
+            break;
+        }
+    }
+    return i;
+}
+
+// AVX2 查表校验（Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte"）：
+// 用前一字节的高/低 4 位和当前字节的高 4 位各查一张 16 项的表，三者相与即得到双字节范围内的错误，
+// 再结合前 2、3 个字节判断必须出现的第 3、4 字节续字节
+constexpr char kTooShort = 1 << 0;
+constexpr char kTooLong = 1 << 1;
+constexpr char kOverlong3 = 1 << 2;
+constexpr char kTooLarge = 1 << 3;
+constexpr char kSurrogate = 1 << 4;
+constexpr char kOverlong2 = 1 << 5;
+constexpr char kTooLarge1000 = 1 << 6;
+constexpr char kOverlong4 = 1 << 6;
+constexpr char kTwoConts = static_cast<char>(1 << 7);
+constexpr char kCarry = kTooShort | kTooLong | kTwoConts;
+
+// 将 previous 的末尾 N 个字节移入 input 的开头
+template<int N>
+__attribute__((target("avx2")))
+inline __m256i shift_in_avx2(__m256i input, __m256i previous) {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+}
+
+__attribute__((target("avx2")))
+inline __m256i high_nibbles_avx2(__m256i bytes) {
+    return _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(0x0F));
+}
+
+__attribute__((target("avx2")))
+inline __m256i check_block_avx2(__m256i input, __m256i previous) {
+    const __m256i byte_1_high_table = _mm256_setr_epi8(
+        kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+        kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+        kTooShort | kOverlong2, kTooShort, kTooShort | kOverlong3 | kSurrogate,
+        kTooShort | kTooLarge | kTooLarge1000 | kOverlong4,
+        kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+        kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+        kTooShort | kOverlong2, kTooShort, kTooShort | kOverlong3 | kSurrogate,
+        kTooShort | kTooLarge | kTooLarge1000 | kOverlong4);
+    constexpr char kLarge = kCarry | kTooLarge | kTooLarge1000;
+    const __m256i byte_1_low_table = _mm256_setr_epi8(
+        kCarry | kOverlong3 | kOverlong2 | kOverlong4, kCarry | kOverlong2, kCarry, kCarry,
+        kCarry | kTooLarge, kLarge, kLarge, kLarge, kLarge, kLarge, kLarge, kLarge, kLarge,
+        kLarge | kSurrogate, kLarge, kLarge,
+        kCarry | kOverlong3 | kOverlong2 | kOverlong4, kCarry | kOverlong2, kCarry, kCarry,
+        kCarry | kTooLarge, kLarge, kLarge, kLarge, kLarge, kLarge, kLarge, kLarge, kLarge,
+        kLarge | kSurrogate, kLarge, kLarge);
+    constexpr char kCont = kTooLong | kOverlong2 | kTwoConts;
+    const __m256i byte_2_high_table = _mm256_setr_epi8(
+        kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+        kCont | kOverlong3 | kTooLarge1000 | kOverlong4, kCont | kOverlong3 | kTooLarge,
+        kCont | kSurrogate | kTooLarge, kCont | kSurrogate | kTooLarge,
+        kTooShort, kTooShort, kTooShort, kTooShort,
+        kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+        kCont | kOverlong3 | kTooLarge1000 | kOverlong4, kCont | kOverlong3 | kTooLarge,
+        kCont | kSurrogate | kTooLarge, kCont | kSurrogate | kTooLarge,
+        kTooShort, kTooShort, kTooShort, kTooShort);
+
+    const __m256i prev1 = shift_in_avx2<1>(input, previous);
+    const __m256i byte_1_high = _mm256_shuffle_epi8(byte_1_high_table, high_nibbles_avx2(prev1));
+    const __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)));
+    const __m256i byte_2_high = _mm256_shuffle_epi8(byte_2_high_table, high_nibbles_avx2(input));
+    const __m256i special_cases = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    // 前 2 个字节是 3/4 字节首字节或前 3 个字节是 4 字节首字节时，当前字节必须是续字节
+    const __m256i prev2 = shift_in_avx2<2>(input, previous);
+    const __m256i prev3 = shift_in_avx2<3>(input, previous);
+    const __m256i is_third_byte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    const __m256i is_fourth_byte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    const __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte),
+                                                          _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_xor_si256(must_be_continuation, special_cases);
+}
+
+__attribute__((target("avx2")))
+bool validate_utf8_avx2(const unsigned char* input, size_t length) {
+    // 块末尾 3 个字节中的首字节需要下一块的续字节补全
+    const __m256i incomplete_max = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+    __m256i error = _mm256_setzero_si256();
+    __m256i previous = _mm256_setzero_si256();
+    __m256i previous_incomplete = _mm256_setzero_si256();
+
+    auto process = [&](__m256i block) __attribute__((target("avx2"))) {
+        if (_mm256_movemask_epi8(block) == 0) {
+            error = _mm256_or_si256(error, previous_incomplete);
+        } else {
+            error = _mm256_or_si256(error, check_block_avx2(block, previous));
+            previous_incomplete = _mm256_subs_epu8(block, incomplete_max);
+        }
+        previous = block;
+    };
+
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        process(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i)));
+        if ((i & 1023) == 0 && !_mm256_testz_si256(error, error)) {
+            return false;
+        }
+    }
+    if (i < length) {
+        // 尾部补零，截断的多字节序列会被当作过短序列报错
+        alignas(32) unsigned char tail[32] = {};
+        std::memcpy(tail, input + i, length - i);
+        process(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+    }
+    error = _mm256_or_si256(error, previous_incomplete);
+    return _mm256_testz_si256(error, error) != 0;
+}
+
+#endif // UTF8_TRANSCODER_X86
+
+// 运行时根据 CPU 特性选择内核，只检测一次
+Kernels select_kernels() {
+#ifdef UTF8_TRANSCODER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return Kernels{widen_ascii_avx2, narrow_ascii_avx2, span_ascii_avx2, scan_ascii_avx2, validate_utf8_avx2};
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return Kernels{widen_ascii_sse2, narrow_ascii_sse2, span_ascii_sse2, scan_ascii_sse2, validate_utf8_scalar};
+    }
+#endif
+    return Kernels{widen_ascii_scalar, narrow_ascii_scalar, span_ascii_scalar, scan_ascii_scalar, validate_utf8_scalar};
+}
+
+const Kernels& kernels() {
+    static const Kernels selected = select_kernels();
+    return selected;
+}
+
+inline bool is_continuation(unsigned char c) {
+    return (c & 0xC0) == 0x80;
+}
+
+// 返回码点编码为 UTF-8 的字节数，非法码点返回 0
+inline size_t encoded_size(uint32_t code_point) {
+    if (code_point < 0x80) {
+        return 1;
+    } else if (code_point < 0x800) {
+        return 2;
+    } else if (code_point < 0x10000) {
+        return (code_point >= 0xD800 && code_point <= 0xDFFF) ? 0 : 3;
+    } else if (code_point <= 0x10FFFF) {
+        return 4;
+    }
+    return 0;
+}
+
+}  // namespace
+
+size_t ascii_prefix_length(const char* input, size_t length) {
+    const auto* in = reinterpret_cast<const unsigned char*>(input);
+    size_t i = kernels().scan(in, length);
+    while (i < length && in[i] < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+bool is_valid(const char* input, size_t length) {
+    return kernels().validate(reinterpret_cast<const unsigned char*>(input), length);
+}
+
+// 规则与 glibc 的 UTF-8 解码器一致：
+// 末尾不完整但前缀合法的序列报告 incomplete，其余错误报告 invalid
+Status decode_sequence(const unsigned char* input, size_t available, uint32_t& code_point, size_t& size) {
+    const unsigned char lead = input[0];
+    uint32_t min_value;
+    if (lead < 0xC2) {
+        return Status::invalid;
+    } else if (lead < 0xE0) {
+        size = 2;
+        code_point = lead & 0x1F;
+        min_value = 0x80;
+    } else if (lead < 0xF0) {
+        size = 3;
+        code_point = lead & 0x0F;
+        min_value = 0x800;
+    } else if (lead < 0xF8) {
+        size = 4;
+        code_point = lead & 0x07;
+        min_value = 0x10000;
+    } else {
+        return Status::invalid;
+    }
+
+    if (available < size) {
+        for (size_t k = 1; k < available; ++k) {
+            if (!is_continuation(input[k])) {
+                return Status::invalid;
+            }
+        }
+        return Status::incomplete;
+    }
+
+    for (size_t k = 1; k < size; ++k) {
+        if (!is_continuation(input[k])) {
+            return Status::invalid;
+        }
+        code_point = (code_point << 6) | (input[k] & 0x3F);
+    }
+
+    if (code_point < min_value || code_point > 0x10FFFF ||
+        (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+        return Status::invalid;
+    }
+    return Status::ok;
+}
+
+size_t encode_code_point(uint32_t code_point, char* output) {
+    auto* out = reinterpret_cast<unsigned char*>(output);
+    if (code_point < 0x80) {
+        out[0] = static_cast<unsigned char>(code_point);
+        return 1;
+    } else if (code_point < 0x800) {
+        out[0] = static_cast<unsigned char>(0xC0 | (code_point >> 6));
+        out[1] = static_cast<unsigned char>(0x80 | (code_point & 0x3F));
+        return 2;
+    } else if (code_point < 0x10000) {
+        out[0] = static_cast<unsigned char>(0xE0 | (code_point >> 12));
+        out[1] = static_cast<unsigned char>(0x80 | ((code_point >> 6) & 0x3F));
+        out[2] = static_cast<unsigned char>(0x80 | (code_point & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<unsigned char>(0xF0 | (code_point >> 18));
+    out[1] = static_cast<unsigned char>(0x80 | ((code_point >> 12) & 0x3F));
+    out[2] = static_cast<unsigned char>(0x80 | ((code_point >> 6) & 0x3F));
+    out[3] = static_cast<unsigned char>(0x80 | (code_point & 0x3F));
+    return 4;
+}
+
+#ifdef STRING_CONVERTER_NATIVE_UTF32
+
+Result utf8_to_wide(const char* input, size_t length, wchar_t* output) {
+    const auto* in = reinterpret_cast<const unsigned char*>(input);
+    const Kernels& k = kernels();
+    size_t i = 0;
+    size_t o = 0;
+    while (i < length) {
+        const size_t ascii = k.widen(in + i, length - i, output + o);
+        i += ascii;
+        o += ascii;
+
+        // 快速路径停下的位置逐字符解码，再次遇到 ASCII 时回到快速路径
+        while (i < length) {
+            const unsigned char c = in[i];
+            if (c < 0x80) {
+                output[o++] = static_cast<wchar_t>(c);
+                ++i;
+                break;
+            }
+            uint32_t code_point = 0;
+            size_t size = 0;
+            const Status status = decode_sequence(in + i, length - i, code_point, size);
+            if (status != Status::ok) {
+                return Result{status, i, o};
+            }
+            output[o++] = static_cast<wchar_t>(code_point);
+            i += size;
+        }
+    }
+    return Result{Status::ok, i, o};
+}
+
+Result wide_to_utf8_length(const wchar_t* input, size_t length) {
+    const Kernels& k = kernels();
+    size_t i = 0;
+    size_t bytes = 0;
+    while (i < length) {
+        const size_t ascii = k.span(input + i, length - i);
+        i += ascii;
+        bytes += ascii;
+
+        while (i < length) {
+            const uint32_t code_point = static_cast<uint32_t>(input[i]);
+            const size_t size = encoded_size(code_point);
+            if (size == 0) {
+                return Result{Status::invalid, i, bytes};
+            }
+            bytes += size;
+            ++i;
+            if (size == 1) {
+                break;
+            }
+        }
+    }
+    return Result{Status::ok, i, bytes};
+}
+
+size_t wide_to_utf8(const wchar_t* input, size_t length, char* output) {
+    const Kernels& k = kernels();
+    size_t i = 0;
+    size_t o = 0;
+    while (i < length) {
+        const size_t ascii = k.narrow(input + i, length - i, output + o);
+        i += ascii;
+        o += ascii;
+
+        while (i < length) {
+            const uint32_t code_point = static_cast<uint32_t>(input[i++]);
+            o += encode_code_point(code_point, output + o);
+            if (code_point < 0x80) {
+                break;
+            }
+        }
+    }
+    return o;
+}
+
+#endif // STRING_CONVERTER_NATIVE_UTF32
+
+}  // namespace utf8_transcoder
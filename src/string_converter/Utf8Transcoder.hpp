@@ -0,0 +1,95 @@
+#ifndef UTF8_TRANSCODER_H
+#define UTF8_TRANSCODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cwchar>
+
+// wchar_t 为 32 位（UTF-32）时才启用内置的 UTF-8 <-> wchar_t 转码器，
+// 其它平台（如 Windows 的 UTF-16 wchar_t）仍走系统接口
+#if !defined(_WIN32) && (WCHAR_MAX > 0xFFFF)
+#define STRING_CONVERTER_NATIVE_UTF32 1
+#endif
+
+namespace utf8_transcoder {
+
+// 转码结果状态，与 iconv 的 errno 语义保持一致
+enum class Status {
+    ok,          // 转换成功
+    invalid,     // 非法序列（EILSEQ）
+    incomplete,  // 输入末尾的多字节序列不完整（EINVAL）
+};
+
+struct Result {
+    Status status;
+    size_t read;     // 已消耗的输入单元数
+    size_t written;  // 已写出的输出单元数
+};
+
+/**
+ * 返回从 input 开始连续 ASCII 字节的个数（SIMD 加速）
+ * @param input 输入字节
+ * @param length 输入字节数
+ * @return 第一个非 ASCII 字节之前的字节数
+ */
+size_t ascii_prefix_length(const char* input, size_t length);
+
+/**
+ * 校验 input 是否为合法的 UTF-8（SIMD 加速），规则与 decode_sequence 一致
+ * @param input 输入字节
+ * @param length 输入字节数
+ * @return 合法时返回 true，末尾不完整的序列视为不合法
+ */
+bool is_valid(const char* input, size_t length);
+
+/**
+ * 解码一个以非 ASCII 字节开头的 UTF-8 序列，校验规则与 glibc 一致
+ * @param input 序列起始位置
+ * @param available 剩余可用字节数
+ * @param code_point 解码得到的码点
+ * @param size 序列占用的字节数
+ * @return 解码状态
+ */
+Status decode_sequence(const unsigned char* input, size_t available, uint32_t& code_point, size_t& size);
+
+/**
+ * 将码点编码为 UTF-8，调用方需保证码点合法
+ * @param code_point 码点（不含代理项，不超过 U+10FFFF）
+ * @param output 输出缓冲区，至少 4 字节
+ * @return 写出的字节数
+ */
+size_t encode_code_point(uint32_t code_point, char* output);
+
+#ifdef STRING_CONVERTER_NATIVE_UTF32
+
+/**
+ * 将 UTF-8 解码为 wchar_t（UTF-32）
+ * @param input UTF-8 字节
+ * @param length 输入字节数
+ * @param output 输出缓冲区，容量至少为 length 个 wchar_t
+ * @return 转换结果，出错时 read 指向出错序列的起始位置
+ */
+Result utf8_to_wide(const char* input, size_t length, wchar_t* output);
+
+/**
+ * 计算 wchar_t（UTF-32）编码为 UTF-8 后的字节数，同时校验输入
+ * @param input 宽字符
+ * @param length 输入字符数
+ * @return 转换结果，成功时 written 为所需的 UTF-8 字节数
+ */
+Result wide_to_utf8_length(const wchar_t* input, size_t length);
+
+/**
+ * 将已通过 wide_to_utf8_length 校验的 wchar_t 编码为 UTF-8
+ * @param input 宽字符
+ * @param length 输入字符数
+ * @param output 输出缓冲区，容量至少为 wide_to_utf8_length 返回的字节数
+ * @return 写出的字节数
+ */
+size_t wide_to_utf8(const wchar_t* input, size_t length, char* output);
+
+#endif // STRING_CONVERTER_NATIVE_UTF32
+
+}  // namespace utf8_transcoder
+
+#endif // UTF8_TRANSCODER_H
@@ -0,0 +1,126 @@
+#include <cpp_sandbox/bit_mask.hpp>
+#include <algorithm>
+
+namespace submatrix_search {
+
+namespace {
+
+inline unsigned popcount(uint64_t word) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return static_cast<unsigned>(__popcnt64(word));
+#else
+    return static_cast<unsigned>(__builtin_popcountll(word));
+#endif
+}
+
+// [begin, begin + width) 位为 1、其余为 0 的字，要求 begin + width <= 64
+inline uint64_t bit_range(size_t begin, size_t width) {
+    const uint64_t bits = width >= BitMask::kBitsPerWord ? ~uint64_t(0) : ((uint64_t(1) << width) - 1);
+    return bits << begin;
+}
+
+// 对一行中 [col, col + width) 覆盖到的每个字调用 func(word_index, bits)
+template<typename Func>
+void for_each_range_word(size_t col, size_t width, Func func) {
+    while (width > 0) {
+        const size_t bit = col % BitMask::kBitsPerWord;
+        const size_t take = std::min(width, BitMask::kBitsPerWord - bit);
+        if (!func(col / BitMask::kBitsPerWord, bit_range(bit, take))) {
+            return;
+        }
+        col += take;
+        width -= take;
+    }
+}
+
+// 将一行稠密单元压缩为位，非 0 单元记为 1；按字累积，避免逐位读写内存
+template<typename T>
+void pack_row(const T* cells, size_t cols, uint64_t* words) {
+    for (size_t begin = 0, w = 0; begin < cols; begin += BitMask::kBitsPerWord, ++w) {
+        const size_t end = std::min(cols, begin + BitMask::kBitsPerWord);
+        uint64_t word = 0;
+        for (size_t j = begin; j < end; ++j) {
+            word |= uint64_t(cells[j] != 0) << (j - begin);
+        }
+        words[w] = word;
+    }
+}
+
+}  // namespace
+
+BitMask::BitMask(size_t rows, size_t cols)
+    : words_(rows, (cols + kBitsPerWord - 1) / kBitsPerWord, 0), cols_(cols) {}
+
+BitMask BitMask::from_grid(const Grid<int>& grid) {
+    BitMask mask(grid.rows(), grid.cols());
+    for (size_t i = 0; i < grid.rows(); ++i) {
+        pack_row(grid.row_data(i), grid.cols(), mask.row_data(i));
+    }
+    return mask;
+}
+
+BitMask BitMask::from_bytes(const uint8_t* cells, size_t rows, size_t cols, size_t row_stride) {
+    BitMask mask(rows, cols);
+    for (size_t i = 0; i < rows; ++i) {
+        pack_row(cells + i * row_stride, cols, mask.row_data(i));
+    }
+    return mask;
+}
+
+BitMask BitMask::from_words(const uint64_t* words, size_t rows, size_t cols, size_t words_per_row) {
+    BitMask mask(rows, cols);
+    for (size_t i = 0; i < rows; ++i) {
+        std::copy(words + i * words_per_row, words + i * words_per_row + mask.words_per_row(), mask.row_data(i));
+    }
+    mask.clear_padding();
+    return mask;
+}
+
+size_t BitMask::count() const {
+    size_t total = 0;
+    for (size_t i = 0; i < rows(); ++i) {
+        const uint64_t* words = row_data(i);
+        for (size_t w = 0; w < words_per_row(); ++w) {
+            total += popcount(words[w]);
+        }
+    }
+    return total;
+}
+
+bool BitMask::any_in_range(size_t row, size_t col, size_t width) const {
+    const uint64_t* words = row_data(row);
+    bool found = false;
+    for_each_range_word(col, width, [&](size_t index, uint64_t bits) {
+        found = (words[index] & bits) != 0;
+        return !found;
+    });
+    return found;
+}
+
+void BitMask::set_range(size_t row, size_t col, size_t width) {
+    uint64_t* words = row_data(row);
+    for_each_range_word(col, width, [&](size_t index, uint64_t bits) {
+        words[index] |= bits;
+        return true;
+    });
+}
+
+void BitMask::clear_range(size_t row, size_t col, size_t width) {
+    uint64_t* words = row_data(row);
+    for_each_range_word(col, width, [&](size_t index, uint64_t bits) {
+        words[index] &= ~bits;
+        return true;
+    });
+}
+
+void BitMask::clear_padding() {
+    const size_t tail = cols_ % kBitsPerWord;
+    if (tail == 0) {
+        return;
+    }
+    for (size_t i = 0; i < rows(); ++i) {
+        row_data(i)[words_per_row() - 1] &= bit_range(0, tail);
+    }
+}
+
+}  // namespace submatrix_search
@@ -0,0 +1,216 @@
+#include <cpp_sandbox/submatrix_search.hpp>
+#include <algorithm>
+
+namespace submatrix_search {
+
+namespace {
+
+inline size_t lowbit(size_t index) {
+    return index & (~index + 1);
+}
+
+}  // namespace
+
+struct FenwickGrid::Impl {
+    Grid<int> cells;
+    // 下标从 1 开始，(m + 1) x (n + 1)，第 0 行、第 0 列不使用
+    Grid<int64_t> tree;
+};
+
+FenwickGrid::FenwickGrid() : impl_(new Impl) {}
+
+FenwickGrid::FenwickGrid(const Grid<int>& grid) : impl_(new Impl) {
+    const size_t m = grid.rows(), n = grid.cols();
+    impl_->cells = grid;
+    Grid<int64_t>& tree = impl_->tree;
+    tree.assign(m + 1, n + 1, 0);
+    for (size_t i = 1; i <= m; ++i) {
+        std::copy(grid.row_data(i - 1), grid.row_data(i - 1) + n, tree.row_data(i) + 1);
+    }
+
+    // 线性构建：先在每行内把每个节点累加到其父节点，再对整行做同样的累加
+    for (size_t i = 1; i <= m; ++i) {
+        int64_t* row = tree.row_data(i);
+        for (size_t j = 1; j <= n; ++j) {
+            const size_t parent = j + lowbit(j);
+            if (parent <= n) {
+                row[parent] += row[j];
+            }
+        }
+    }
+    for (size_t i = 1; i <= m; ++i) {
+        const size_t parent = i + lowbit(i);
+        if (parent > m) {
+            continue;
+        }
+        const int64_t* row = tree.row_data(i);
+        int64_t* parentRow = tree.row_data(parent);
+        for (size_t j = 1; j <= n; ++j) {
+            parentRow[j] += row[j];
+        }
+    }
+}
+
+FenwickGrid::~FenwickGrid() = default;
+
+FenwickGrid::FenwickGrid(const FenwickGrid& other) : impl_(new Impl(*other.impl_)) {}
+
+FenwickGrid& FenwickGrid::operator=(const FenwickGrid& other) {
+    if (this != &other) {
+        impl_.reset(new Impl(*other.impl_));
+    }
+    return *this;
+}
+
+FenwickGrid::FenwickGrid(FenwickGrid&& other) noexcept = default;
+FenwickGrid& FenwickGrid::operator=(FenwickGrid&& other) noexcept = default;
+
+size_t FenwickGrid::rows() const { return impl_->cells.rows(); }
+size_t FenwickGrid::cols() const { return impl_->cells.cols(); }
+
+int FenwickGrid::get(int row, int col) const {
+    return impl_->cells(static_cast<size_t>(row), static_cast<size_t>(col));
+}
+
+void FenwickGrid::add(int row, int col, int delta) {
+    impl_->cells(static_cast<size_t>(row), static_cast<size_t>(col)) += delta;
+    const size_t m = rows(), n = cols();
+    for (size_t i = static_cast<size_t>(row) + 1; i <= m; i += lowbit(i)) {
+        int64_t* node = impl_->tree.row_data(i);
+        for (size_t j = static_cast<size_t>(col) + 1; j <= n; j += lowbit(j)) {
+            node[j] += delta;
+        }
+    }
+}
+
+void FenwickGrid::set(int row, int col, int value) {
+    const int delta = value - get(row, col);
+    if (delta != 0) {
+        add(row, col, delta);
+    }
+}
+
+int64_t FenwickGrid::prefixSum(size_t rows, size_t cols) const {
+    int64_t sum = 0;
+    for (size_t i = rows; i > 0; i -= lowbit(i)) {
+        const int64_t* node = impl_->tree.row_data(i);
+        for (size_t j = cols; j > 0; j -= lowbit(j)) {
+            sum += node[j];
+        }
+    }
+    return sum;
+}
+
+int64_t FenwickGrid::windowSum(int row, int col, int x, int y) const {
+    const size_t top = static_cast<size_t>(row), left = static_cast<size_t>(col);
+    const size_t bottom = top + static_cast<size_t>(x), right = left + static_cast<size_t>(y);
+    return prefixSum(bottom, right) - prefixSum(top, right) - prefixSum(bottom, left) + prefixSum(top, left);
+}
+
+struct WindowTracker::Impl {
+    int x = 0, y = 0;
+    // 只记录单元是否为非 0，窗口和等于 x * y 即全为非 0
+    FenwickGrid occupied;
+    BitMask valid;
+};
+
+WindowTracker::WindowTracker(const Grid<int>& grid, int x, int y) : impl_(new Impl) {
+    impl_->x = x;
+    impl_->y = y;
+    Grid<int> occupied(grid.rows(), grid.cols());
+    for (size_t i = 0; i < grid.rows(); ++i) {
+        const int* cells = grid.row_data(i);
+        int* out = occupied.row_data(i);
+        for (size_t j = 0; j < grid.cols(); ++j) {
+            out[j] = cells[j] != 0 ? 1 : 0;
+        }
+    }
+    impl_->occupied = FenwickGrid(occupied);
+    impl_->valid = allOnesWindows(BitMask::from_grid(occupied), x, y);
+}
+
+WindowTracker::~WindowTracker() = default;
+WindowTracker::WindowTracker(WindowTracker&& other) noexcept = default;
+WindowTracker& WindowTracker::operator=(WindowTracker&& other) noexcept = default;
+
+int WindowTracker::windowRows() const { return impl_->x; }
+int WindowTracker::windowCols() const { return impl_->y; }
+const FenwickGrid& WindowTracker::grid() const { return impl_->occupied; }
+
+void WindowTracker::update(const std::vector<CellChange>& changes) {
+    const int x = impl_->x, y = impl_->y;
+    const int lastRow = static_cast<int>(impl_->occupied.rows()) - x;
+    const int lastCol = static_cast<int>(impl_->occupied.cols()) - y;
+    if (x < 1 || y < 1 || lastRow < 0 || lastCol < 0) {
+        // 窗口放不下时没有任何左上角，只需记录单元
+        for (const CellChange& change : changes) {
+            impl_->occupied.set(change.row, change.col, change.value != 0 ? 1 : 0);
+        }
+        return;
+    }
+
+    // 单元 (r, c) 影响的左上角范围，已裁剪到网格内
+    struct Region {
+        int top, bottom, left, right;
+    };
+    auto affected = [&](int row, int col) {
+        return Region{std::max(0, row - x + 1), std::min(row, lastRow), std::max(0, col - y + 1), std::min(col, lastCol)};
+    };
+
+    // 先写入整批修改，变为 0 的单元直接清除受影响的窗口；
+    // 变为非 0 的单元记下，最后在整批修改后的网格上重新检查
+    std::vector<Region> raised;
+    for (const CellChange& change : changes) {
+        const int value = change.value != 0 ? 1 : 0;
+        if (impl_->occupied.get(change.row, change.col) == value) {
+            continue;
+        }
+        impl_->occupied.set(change.row, change.col, value);
+        const Region region = affected(change.row, change.col);
+        if (value != 0) {
+            raised.push_back(region);
+            continue;
+        }
+        const size_t width = static_cast<size_t>(region.right - region.left + 1);
+        for (int i = region.top; i <= region.bottom; ++i) {
+            impl_->valid.clear_range(static_cast<size_t>(i), static_cast<size_t>(region.left), width);
+        }
+    }
+
+    // 已有效的窗口只包含未被清零的单元，整批修改后仍然有效，不必重新求和
+    const int64_t area = static_cast<int64_t>(x) * y;
+    for (const Region& region : raised) {
+        for (int i = region.top; i <= region.bottom; ++i) {
+            for (int j = region.left; j <= region.right; ++j) {
+                if (!impl_->valid.get(static_cast<size_t>(i), static_cast<size_t>(j)) &&
+                    impl_->occupied.windowSum(i, j, x, y) == area) {
+                    impl_->valid.set(static_cast<size_t>(i), static_cast<size_t>(j));
+                }
+            }
+        }
+    }
+}
+
+bool WindowTracker::isValid(int row, int col) const {
+    return impl_->valid.get(static_cast<size_t>(row), static_cast<size_t>(col));
+}
+
+const BitMask& WindowTracker::validPositions() const { return impl_->valid; }
+
+std::vector<std::pair<int, int>> WindowTracker::positions() const {
+    const BitMask& valid = impl_->valid;
+    std::vector<std::pair<int, int>> res;
+    res.reserve(valid.count());
+    for (size_t i = 0; i < valid.rows(); ++i) {
+        const uint64_t* row = valid.row_data(i);
+        for (size_t w = 0; w < valid.words_per_row(); ++w) {
+            for (uint64_t bits = row[w]; bits != 0; bits &= bits - 1) {
+                const size_t j = w * BitMask::kBitsPerWord + lowest_set_bit(bits);
+                res.emplace_back(static_cast<int>(i), static_cast<int>(j));
+            }
+        }
+    }
+    return res;
+}
+
+}  // namespace submatrix_search
@@ -0,0 +1,57 @@
+#ifndef SUBMATRIX_SEARCH_GREEDY_SELECTOR_HPP
+#define SUBMATRIX_SEARCH_GREEDY_SELECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace submatrix_search {
+
+// 按行优先顺序贪心选取互不重叠的 x 行 y 列子矩阵，每个候选 O(1) 均摊判断。
+// 候选按行优先、列次之升序提供，已选子矩阵的首行都不晚于当前候选行 i，
+// 因此只需记录每列被覆盖到的行上界 coveredUntil：候选 (i, j) 与之前各行选中的子矩阵重叠，
+// 当且仅当 [j, j + y) 中有列满足 coveredUntil > i。每进入一个有候选的新行时重建这些列的前缀计数；
+// 同一行内已选子矩阵只可能与其右侧 y 列内的候选重叠，用 rowEnd 记录
+class GreedySelector {
+public:
+    // 候选的列号范围为 [colBegin, colBegin + width)
+    GreedySelector(int colBegin, size_t width, int x, int y)
+        : colBegin_(colBegin), x_(x), y_(y),
+          coveredUntil_(width + static_cast<size_t>(y), 0),
+          blockedPrefix_(width + static_cast<size_t>(y) + 1, 0) {}
+
+    // 候选 (i, col) 与已选子矩阵都不重叠时选中并返回 true
+    bool offer(int i, int col) {
+        const int j = col - colBegin_;
+        if(!started_ || i != row_) {
+            started_ = true;
+            row_ = i;
+            rowEnd_ = 0;
+            // 在当前行仍被覆盖的列的前缀计数；尚未选中任何子矩阵时全为 0，不必重建
+            if(anyCovered_) {
+                for(size_t c = 0; c < coveredUntil_.size(); ++c)
+                    blockedPrefix_[c + 1] = blockedPrefix_[c] + (coveredUntil_[c] > i ? 1 : 0);
+            }
+        }
+        if(j < rowEnd_)
+            return false;
+        if(blockedPrefix_[static_cast<size_t>(j + y_)] != blockedPrefix_[static_cast<size_t>(j)])
+            return false;
+
+        rowEnd_ = j + y_;
+        std::fill_n(coveredUntil_.begin() + j, y_, i + x_);
+        anyCovered_ = true;
+        return true;
+    }
+
+private:
+    int colBegin_, x_, y_;
+    std::vector<int> coveredUntil_;
+    std::vector<int> blockedPrefix_;
+    bool started_ = false, anyCovered_ = false;
+    int row_ = 0, rowEnd_ = 0;
+};
+
+}  // namespace submatrix_search
+
+#endif // SUBMATRIX_SEARCH_GREEDY_SELECTOR_HPP
@@ -0,0 +1,117 @@
+#include <cpp_sandbox/submatrix_search.hpp>
+#include "greedy_selector.hpp"
+#include <algorithm>
+
+#ifndef _WIN32
+#include "mapped_file.hpp"
+#include <stdexcept>
+#endif
+
+namespace submatrix_search {
+
+struct StreamingSubmatrixSearch::Impl {
+    Impl(size_t cols, int x, int y, Sink sink, bool checkOverlap)
+        : cols(cols), x(x), y(y), sink(std::move(sink)), checkOverlap(checkOverlap),
+          heights(cols, 0), selector(0, cols, x, y) {}
+
+    size_t cols;
+    int x, y;
+    Sink sink;
+    bool checkOverlap;
+    size_t rows = 0;
+    // 每列到当前行为止向上连续非 0 的个数，达到 x 后不再增加
+    std::vector<uint32_t> heights;
+    GreedySelector selector;
+    std::vector<int> matches;
+
+    template<typename T>
+    void pushRow(const T* cells) {
+        const uint32_t height = static_cast<uint32_t>(std::max(x, 0));
+        for (size_t j = 0; j < cols; ++j) {
+            heights[j] = cells[j] != 0 ? std::min(heights[j] + 1, height) : 0;
+        }
+        ++rows;
+        if (x < 1 || y < 1 || static_cast<size_t>(y) > cols || rows < static_cast<size_t>(x)) {
+            return;
+        }
+
+        // 左上角在 top 行的窗口：每段高度达到 x 的连续列 [begin, end) 中，左上角为 [begin, end - y]
+        const int top = static_cast<int>(rows - static_cast<size_t>(x));
+        const size_t width = static_cast<size_t>(y);
+        matches.clear();
+        for (size_t j = 0; j < cols;) {
+            if (heights[j] < height) {
+                ++j;
+                continue;
+            }
+            const size_t begin = j;
+            while (j < cols && heights[j] >= height) {
+                ++j;
+            }
+            for (size_t s = begin; s + width <= j; ++s) {
+                if (!checkOverlap) {
+                    matches.push_back(static_cast<int>(s));
+                } else if (selector.offer(top, static_cast<int>(s))) {
+                    // 选中后本行接下来的 y - 1 列必然重叠
+                    matches.push_back(static_cast<int>(s));
+                    s += width - 1;
+                }
+            }
+        }
+        if (!matches.empty()) {
+            sink(top, matches);
+        }
+    }
+};
+
+StreamingSubmatrixSearch::StreamingSubmatrixSearch(size_t cols, int x, int y, Sink sink, bool checkOverlap)
+    : impl_(new Impl(cols, x, y, std::move(sink), checkOverlap)) {}
+
+StreamingSubmatrixSearch::~StreamingSubmatrixSearch() = default;
+StreamingSubmatrixSearch::StreamingSubmatrixSearch(StreamingSubmatrixSearch&& other) noexcept = default;
+StreamingSubmatrixSearch& StreamingSubmatrixSearch::operator=(StreamingSubmatrixSearch&& other) noexcept = default;
+
+size_t StreamingSubmatrixSearch::cols() const { return impl_->cols; }
+size_t StreamingSubmatrixSearch::rowsRead() const { return impl_->rows; }
+
+void StreamingSubmatrixSearch::pushRow(const int* cells) { impl_->pushRow(cells); }
+void StreamingSubmatrixSearch::pushRow(const uint8_t* cells) { impl_->pushRow(cells); }
+
+void StreamingSubmatrixSearch::pushRows(const int* cells, size_t rows, size_t rowStride) {
+    for (size_t i = 0; i < rows; ++i) {
+        impl_->pushRow(cells + i * rowStride);
+    }
+}
+
+void StreamingSubmatrixSearch::pushRows(const uint8_t* cells, size_t rows, size_t rowStride) {
+    for (size_t i = 0; i < rows; ++i) {
+        impl_->pushRow(cells + i * rowStride);
+    }
+}
+
+#ifndef _WIN32
+void searchRawMaskFile(
+    const std::string& path,
+    size_t cols,
+    int x, int y,
+    const StreamingSubmatrixSearch::Sink& sink,
+    bool checkOverlap,
+    size_t stripRows
+) {
+    MappedFile mask(path);
+    if (cols == 0 || mask.size() % cols != 0) {
+        throw std::runtime_error(path + ": size is not a multiple of the row length");
+    }
+    const size_t rows = mask.size() / cols;
+    stripRows = std::max<size_t>(stripRows, 1);
+
+    StreamingSubmatrixSearch search(cols, x, y, sink, checkOverlap);
+    for (size_t row = 0; row < rows; row += stripRows) {
+        const size_t count = std::min(stripRows, rows - row);
+        search.pushRows(mask.data() + row * cols, count, cols);
+        mask.release((row + count) * cols);
+    }
+}
+#endif
+
+}  // namespace submatrix_search
@@ -0,0 +1,563 @@
+#include <cpp_sandbox/submatrix_search.hpp>
+#include "greedy_selector.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <numeric>
+#include <thread>
+using namespace std;
+
+namespace submatrix_search {
+
+// 构建前缀和时每块的列数，块内的行累加和与上一行的对应块都留在 L1 缓存中
+static const size_t kPrefixSumBlock = 2048;
+
+template<typename Acc>
+static void buildPrefixSumImpl(const Grid<int>& grid, Grid<Acc>& sum) {
+    size_t m = grid.rows(), n = grid.cols();
+    sum.reshape(m + 1, n + 1);
+    fill_n(sum.row_data(0), n + 1, Acc(0));
+    for(size_t i = 1; i <= m; ++i) {
+        const int* g = grid.row_data(i - 1);
+        const Acc* above = sum.row_data(i - 1);
+        Acc* cur = sum.row_data(i);
+        cur[0] = 0;
+        Acc run = 0;
+        for(size_t begin = 0; begin < n; begin += kPrefixSumBlock) {
+            const size_t end = min(n, begin + kPrefixSumBlock);
+            // 行内累加和：只有一条加法依赖链
+            for(size_t j = begin; j < end; ++j) {
+                run += static_cast<Acc>(g[j]);
+                cur[j+1] = run;
+            }
+            // 加上一行的前缀和：各列独立，可以向量化
+            for(size_t j = begin; j < end; ++j)
+                cur[j+1] += above[j+1];
+        }
+    }
+}
+
+void buildPrefixSum(const Grid<int>& grid, Grid<uint32_t>& sum) {
+    buildPrefixSumImpl(grid, sum);
+}
+
+void buildPrefixSum(const Grid<int>& grid, Grid<uint64_t>& sum) {
+    buildPrefixSumImpl(grid, sum);
+}
+
+bool prefixSumFitsUint32(size_t rows, size_t cols) {
+    return cols == 0 || rows <= UINT32_MAX / cols;
+}
+
+// 在 threadCount 个线程上执行 func(0) ... func(threadCount - 1)，第 0 份在调用线程上执行；
+// 任一份抛出异常时，等待全部结束后重新抛出第一个异常
+template<typename Func>
+static void runParallel(size_t threadCount, const Func& func) {
+    vector<exception_ptr> errors(threadCount);
+    auto guarded = [&](size_t index) {
+        try {
+            func(index);
+        } catch(...) {
+            errors[index] = current_exception();
+        }
+    };
+    vector<thread> workers;
+    workers.reserve(threadCount - 1);
+    for(size_t t = 1; t < threadCount; ++t)
+        workers.emplace_back(guarded, t);
+    guarded(0);
+    for(thread& worker : workers)
+        worker.join();
+    for(const exception_ptr& error : errors)
+        if(error) rethrow_exception(error);
+}
+
+static unsigned resolveThreadCount(unsigned threadCount) {
+    return threadCount == 0 ? max(1u, thread::hardware_concurrency()) : threadCount;
+}
+
+// 两遍分块构建：先按行带并行求每行的行内累加和，再按列块并行向下逐行累加。
+// 列块宽度为缓存行的整数倍，不同线程不会写同一缓存行
+template<typename Acc>
+static void buildPrefixSumParallelImpl(const Grid<int>& grid, Grid<Acc>& sum, unsigned threadCount) {
+    if(threadCount <= 1) {
+        // 两遍构建要多读写一次整个表，单线程时使用一遍完成的串行版本
+        buildPrefixSumImpl(grid, sum);
+        return;
+    }
+    size_t m = grid.rows(), n = grid.cols();
+    sum.reshape(m + 1, n + 1);
+    fill_n(sum.row_data(0), n + 1, Acc(0));
+    const size_t threads = min<size_t>(max<size_t>(m, 1), threadCount);
+
+    runParallel(threads, [&](size_t t) {
+        for(size_t i = 1 + m * t / threads; i < 1 + m * (t + 1) / threads; ++i) {
+            const int* g = grid.row_data(i - 1);
+            Acc* cur = sum.row_data(i);
+            cur[0] = 0;
+            Acc run = 0;
+            for(size_t j = 0; j < n; ++j) {
+                run += static_cast<Acc>(g[j]);
+                cur[j+1] = run;
+            }
+        }
+    });
+
+    const size_t lineElements = Grid<Acc>::kAlignment / sizeof(Acc);
+    const size_t lines = (n + 1 + lineElements - 1) / lineElements;
+    const size_t columnThreads = min<size_t>(lines, threadCount);
+    runParallel(columnThreads, [&](size_t t) {
+        const size_t begin = min(n + 1, lines * t / columnThreads * lineElements);
+        const size_t end = min(n + 1, lines * (t + 1) / columnThreads * lineElements);
+        for(size_t i = 2; i <= m; ++i) {
+            const Acc* above = sum.row_data(i - 1);
+            Acc* cur = sum.row_data(i);
+            for(size_t j = begin; j < end; ++j)
+                cur[j] += above[j];
+        }
+    });
+}
+
+void buildPrefixSumParallel(const Grid<int>& grid, Grid<uint32_t>& sum, unsigned threadCount) {
+    buildPrefixSumParallelImpl(grid, sum, resolveThreadCount(threadCount));
+}
+
+void buildPrefixSumParallel(const Grid<int>& grid, Grid<uint64_t>& sum, unsigned threadCount) {
+    buildPrefixSumParallelImpl(grid, sum, resolveThreadCount(threadCount));
+}
+
+// 扫描左上角行号在 [rowBegin, rowEnd) 内的窗口，按行优先顺序追加全 1 窗口的左上角
+template<typename Acc>
+static void scanWindows(const Grid<Acc>& sum, int x, int y, int rowBegin, int rowEnd, vector<pair<int, int>>& res) {
+    const int n = static_cast<int>(sum.cols()) - 1;
+    // 无符号减法按模运算，窗口内的和始终是精确值
+    const Acc area = static_cast<Acc>(x) * static_cast<Acc>(y);
+    for(int i = rowBegin; i < rowEnd; ++i) {
+        const Acc* top = sum.row_data(static_cast<size_t>(i));
+        const Acc* bottom = sum.row_data(static_cast<size_t>(i + x));
+        for(int j = 0; j <= n - y; ++j) {
+            Acc areaSum = bottom[j+y] - top[j+y] - bottom[j] + top[j];
+            if(areaSum == area)
+                res.emplace_back(i, j);
+        }
+    }
+}
+
+// 按 rects 的顺序贪心选取互不重叠的 x 行 y 列子矩阵，rects 须按行优先、列次之升序排列
+static vector<pair<int, int>> selectNonOverlapping(const vector<pair<int, int>>& rects, int x, int y) {
+    // 面积为 0 的窗口互不重叠
+    if(x < 1 || y < 1)
+        return rects;
+    vector<pair<int, int>> selected;
+    if(rects.empty())
+        return selected;
+    int minCol = rects.front().second, maxCol = rects.front().second;
+    for(const auto& p : rects) {
+        minCol = min(minCol, p.second);
+        maxCol = max(maxCol, p.second);
+    }
+    GreedySelector selector(minCol, static_cast<size_t>(maxCol - minCol + 1), x, y);
+    for(const auto& p : rects)
+        if(selector.offer(p.first, p.second))
+            selected.push_back(p);
+    return selected;
+}
+
+// 在已构建的前缀和上查找所有 x 行 y 列 的全 1 子矩阵左上角坐标
+template<typename Acc>
+static vector<pair<int, int>> searchPrefixSum(const Grid<Acc>& sum, int x, int y, bool checkOverlap) {
+    if(x < 1 || y < 1)
+        return {};
+    int m = static_cast<int>(sum.rows()) - 1, n = static_cast<int>(sum.cols()) - 1;
+    vector<pair<int, int>> res;
+    if(!checkOverlap) {
+        scanWindows(sum, x, y, 0, m - x + 1, res);
+        return res;
+    }
+
+    // 扫描的同时贪心选取，选中后本行接下来的 y - 1 列必然重叠，直接跳过
+    GreedySelector selector(0, static_cast<size_t>(n), x, y);
+    const Acc area = static_cast<Acc>(x) * static_cast<Acc>(y);
+    for(int i = 0; i <= m - x; ++i) {
+        const Acc* top = sum.row_data(static_cast<size_t>(i));
+        const Acc* bottom = sum.row_data(static_cast<size_t>(i + x));
+        for(int j = 0; j <= n - y; ++j) {
+            Acc areaSum = bottom[j+y] - top[j+y] - bottom[j] + top[j];
+            if(areaSum == area && selector.offer(i, j)) {
+                res.emplace_back(i, j);
+                j += y - 1;
+            }
+        }
+    }
+    return res;
+}
+
+template<typename Acc>
+static vector<pair<int, int>> findSubmatricesImpl(
+    const Grid<int>& grid,
+    int x, int y,
+    Grid<Acc>& sum,
+    bool checkOverlap
+) {
+    buildPrefixSum(grid, sum);
+    return searchPrefixSum(sum, x, y, checkOverlap);
+}
+
+vector<pair<int, int>> findSubmatrices(const Grid<int>& grid, int x, int y, Grid<uint32_t>& sum, bool checkOverlap) {
+    return findSubmatricesImpl(grid, x, y, sum, checkOverlap);
+}
+
+vector<pair<int, int>> findSubmatrices(const Grid<int>& grid, int x, int y, Grid<uint64_t>& sum, bool checkOverlap) {
+    return findSubmatricesImpl(grid, x, y, sum, checkOverlap);
+}
+
+vector<pair<int, int>> findSubmatrices(const Grid<int>& grid, int x, int y, bool checkOverlap) {
+    if(prefixSumFitsUint32(grid.rows(), grid.cols())) {
+        Grid<uint32_t> sum;
+        return findSubmatricesImpl(grid, x, y, sum, checkOverlap);
+    }
+    Grid<uint64_t> sum;
+    return findSubmatricesImpl(grid, x, y, sum, checkOverlap);
+}
+
+// 候选行按行带分给各线程，各自写入独立的结果数组，再按行带顺序拼接，结果与串行版本完全相同
+template<typename Acc>
+static vector<pair<int, int>> findSubmatricesParallelImpl(
+    const Grid<int>& grid,
+    int x, int y,
+    bool checkOverlap,
+    unsigned threadCount
+) {
+    const int candidateRows = static_cast<int>(grid.rows()) - x + 1;
+    if(x < 1 || y < 1 || candidateRows <= 0 || y > static_cast<int>(grid.cols()))
+        return vector<pair<int, int>>();
+
+    Grid<Acc> sum;
+    buildPrefixSumParallelImpl(grid, sum, threadCount);
+
+    // 行带数多于线程数，减少窗口分布不均时的等待；每个线程按顺序领取下一个行带
+    const size_t bandCount = min<size_t>(static_cast<size_t>(candidateRows), size_t(threadCount) * 4);
+    vector<vector<pair<int, int>>> bands(bandCount);
+    atomic<size_t> nextBand(0);
+    runParallel(min<size_t>(threadCount, bandCount), [&](size_t) {
+        for(size_t band = nextBand++; band < bandCount; band = nextBand++) {
+            const int begin = static_cast<int>(candidateRows * band / bandCount);
+            const int end = static_cast<int>(candidateRows * (band + 1) / bandCount);
+            scanWindows(sum, x, y, begin, end, bands[band]);
+        }
+    });
+
+    size_t total = 0;
+    for(const auto& band : bands)
+        total += band.size();
+    vector<pair<int, int>> res;
+    res.reserve(total);
+    for(const auto& band : bands)
+        res.insert(res.end(), band.begin(), band.end());
+    if(checkOverlap)
+        return selectNonOverlapping(res, x, y);
+    return res;
+}
+
+vector<pair<int, int>> findSubmatricesParallel(const Grid<int>& grid, int x, int y, bool checkOverlap, unsigned threadCount) {
+    threadCount = resolveThreadCount(threadCount);
+    if(prefixSumFitsUint32(grid.rows(), grid.cols()))
+        return findSubmatricesParallelImpl<uint32_t>(grid, x, y, checkOverlap, threadCount);
+    return findSubmatricesParallelImpl<uint64_t>(grid, x, y, checkOverlap, threadCount);
+}
+
+// 将一行位向右移动 shift 位（第 j 列取原来第 j + shift 列的值），超出行尾的部分补 0
+static void shiftRowRight(const uint64_t* src, uint64_t* dst, size_t words, size_t shift) {
+    const size_t wordShift = shift / BitMask::kBitsPerWord;
+    const size_t bitShift = shift % BitMask::kBitsPerWord;
+    for(size_t w = 0; w < words; ++w) {
+        const size_t k = w + wordShift;
+        const uint64_t lo = k < words ? src[k] : 0;
+        const uint64_t hi = k + 1 < words ? src[k + 1] : 0;
+        dst[w] = bitShift == 0 ? lo : (lo >> bitShift) | (hi << (BitMask::kBitsPerWord - bitShift));
+    }
+}
+
+BitMask allOnesWindows(const BitMask& mask, int x, int y) {
+    const size_t m = mask.rows(), words = mask.words_per_row();
+    BitMask result(m, mask.cols());
+    if(x < 1 || y < 1 || static_cast<size_t>(x) > m || static_cast<size_t>(y) > mask.cols())
+        return result;
+
+    // 行内：runs 的第 j 位表示第 j 列起连续 y 个单元全为 1。
+    // cur 保存长度为 len 的连续 1，每轮长度翻倍；y 的二进制位为 1 时把 cur 平移 offset 后并入结果
+    BitMask runs(m, mask.cols());
+    vector<uint64_t> cur(words), shifted(words);
+    for(size_t i = 0; i < m; ++i) {
+        uint64_t* out = runs.row_data(i);
+        fill(out, out + words, ~uint64_t(0));
+        copy(mask.row_data(i), mask.row_data(i) + words, cur.begin());
+        size_t len = 1, offset = 0;
+        for(size_t remaining = static_cast<size_t>(y); remaining > 0; ) {
+            if(remaining & 1) {
+                shiftRowRight(cur.data(), shifted.data(), words, offset);
+                for(size_t w = 0; w < words; ++w) out[w] &= shifted[w];
+                offset += len;
+            }
+            remaining >>= 1;
+            if(remaining > 0) {
+                shiftRowRight(cur.data(), shifted.data(), words, len);
+                for(size_t w = 0; w < words; ++w) cur[w] &= shifted[w];
+                len *= 2;
+            }
+        }
+    }
+
+    // 跨行：同样按倍增方式求连续 x 行的与，runs 原地更新为长度为 len 的结果
+    for(size_t i = 0; i < m; ++i) {
+        uint64_t* out = result.row_data(i);
+        fill(out, out + words, ~uint64_t(0));
+    }
+    size_t len = 1, offset = 0;
+    for(size_t remaining = static_cast<size_t>(x); remaining > 0; ) {
+        if(remaining & 1) {
+            for(size_t i = 0; i < m; ++i) {
+                uint64_t* out = result.row_data(i);
+                if(i + offset < m) {
+                    const uint64_t* src = runs.row_data(i + offset);
+                    for(size_t w = 0; w < words; ++w) out[w] &= src[w];
+                } else {
+                    fill(out, out + words, 0);
+                }
+            }
+            offset += len;
+        }
+        remaining >>= 1;
+        if(remaining > 0) {
+            // 按行号递增处理，读取的第 i + len 行尚未更新
+            for(size_t i = 0; i < m; ++i) {
+                uint64_t* dst = runs.row_data(i);
+                if(i + len < m) {
+                    const uint64_t* src = runs.row_data(i + len);
+                    for(size_t w = 0; w < words; ++w) dst[w] &= src[w];
+                } else {
+                    fill(dst, dst + words, 0);
+                }
+            }
+            len *= 2;
+        }
+    }
+    return result;
+}
+
+vector<pair<int, int>> findSubmatrices(
+    const BitMask& mask,
+    int x, int y,
+    bool checkOverlap
+) {
+    const BitMask windows = allOnesWindows(mask, x, y);
+    vector<pair<int, int>> res;
+    if(!checkOverlap)
+        res.reserve(windows.count());
+    // 与稠密版本相同，按行优先顺序枚举，并在此顺序上贪心选取互不重叠的窗口
+    GreedySelector selector(0, mask.cols(), x, y);
+    for(size_t i = 0; i < windows.rows(); ++i) {
+        const uint64_t* row = windows.row_data(i);
+        for(size_t w = 0; w < windows.words_per_row(); ++w) {
+            for(uint64_t bits = row[w]; bits != 0; bits &= bits - 1) {
+                const int j = static_cast<int>(w * BitMask::kBitsPerWord + lowest_set_bit(bits));
+                if(!checkOverlap || selector.offer(static_cast<int>(i), j))
+                    res.emplace_back(static_cast<int>(i), j);
+            }
+        }
+    }
+    return res;
+}
+
+// 对子矩阵左上角坐标进行聚类，能通过上下左右平移连接起来的归为一类
+// 并查集：按路径减半查找根，合并时总把下标较大的根挂到较小的根下。
+// 只合并同一区间内的下标时，各线程只会读写自己区间内的 parent，可以并行
+static int findRoot(vector<int>& parent, int i) {
+    while(parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+static void unite(vector<int>& parent, int a, int b) {
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if(a == b) return;
+    if(a < b) swap(a, b);
+    parent[a] = b;
+}
+
+// 合并上下相邻两行中列号相同的候选；sorted[upper...) 与 sorted[lower...) 分别为这两行，均按列升序
+static void uniteRows(const vector<pair<int, int>>& sorted,
+                      size_t upperBegin, size_t upperEnd,
+                      size_t lowerBegin, size_t lowerEnd,
+                      vector<int>& parent) {
+    size_t above = upperBegin;
+    for(size_t k = lowerBegin; k < lowerEnd && above < upperEnd; ++k) {
+        while(above < upperEnd && sorted[above].second < sorted[k].second) ++above;
+        if(above < upperEnd && sorted[above].second == sorted[k].second)
+            unite(parent, static_cast<int>(above), static_cast<int>(k));
+    }
+}
+
+// sorted[begin, end) 中与 pos 同一行的候选的起止位置
+static size_t rowBeginOf(const vector<pair<int, int>>& sorted, size_t begin, size_t pos) {
+    while(pos > begin && sorted[pos - 1].first == sorted[pos].first) --pos;
+    return pos;
+}
+
+static size_t rowEndOf(const vector<pair<int, int>>& sorted, size_t end, size_t pos) {
+    const int row = sorted[pos].first;
+    while(pos < end && sorted[pos].first == row) ++pos;
+    return pos;
+}
+
+// 对 sorted[begin, end) 做两遍连通域标记的第一遍：逐行合并左侧和上方相邻的候选
+static void labelRange(const vector<pair<int, int>>& sorted, size_t begin, size_t end, vector<int>& parent) {
+    size_t prevBegin = begin, prevEnd = begin;
+    for(size_t rowBegin = begin; rowBegin < end;) {
+        const size_t rowEnd = rowEndOf(sorted, end, rowBegin);
+        for(size_t k = rowBegin + 1; k < rowEnd; ++k)
+            if(sorted[k - 1].second + 1 == sorted[k].second)
+                unite(parent, static_cast<int>(k - 1), static_cast<int>(k));
+        if(prevEnd > prevBegin && sorted[prevBegin].first + 1 == sorted[rowBegin].first)
+            uniteRows(sorted, prevBegin, prevEnd, rowBegin, rowEnd, parent);
+        prevBegin = rowBegin;
+        prevEnd = rowEnd;
+        rowBegin = rowEnd;
+    }
+}
+
+// 将候选按行优先排序去重后做连通域标记，再按 rects 的顺序输出各聚类。
+// 排序后的候选按整行切分为 bandCount 个行带，各行带在独立线程上标记，最后串行合并行带交界处的两行
+static vector<vector<pair<int, int>>> clusterSubmatricesImpl(const vector<pair<int, int>>& rects, size_t bandCount) {
+    const size_t n = rects.size();
+    // rects 中各下标按坐标稳定排序；findSubmatrices 的结果本身有序，不必再排
+    vector<int> order(n);
+    iota(order.begin(), order.end(), 0);
+    if(!is_sorted(rects.begin(), rects.end()))
+        stable_sort(order.begin(), order.end(), [&](int a, int b) { return rects[a] < rects[b]; });
+
+    // 重复的坐标只保留最先出现的一个，其余记为 -1
+    vector<pair<int, int>> sorted;
+    sorted.reserve(n);
+    vector<int> position(n);
+    for(int i : order) {
+        if(!sorted.empty() && sorted.back() == rects[i]) {
+            position[i] = -1;
+            continue;
+        }
+        position[i] = static_cast<int>(sorted.size());
+        sorted.push_back(rects[i]);
+    }
+
+    vector<int> parent(sorted.size());
+    iota(parent.begin(), parent.end(), 0);
+
+    // 行带边界取在整行的起点
+    bandCount = max<size_t>(1, min(bandCount, sorted.size()));
+    vector<size_t> bounds(bandCount + 1, sorted.size());
+    bounds[0] = 0;
+    for(size_t band = 1; band < bandCount; ++band)
+        bounds[band] = max(bounds[band - 1], rowBeginOf(sorted, 0, sorted.size() * band / bandCount));
+    if(bandCount == 1) {
+        labelRange(sorted, 0, sorted.size(), parent);
+    } else {
+        runParallel(bandCount, [&](size_t band) { labelRange(sorted, bounds[band], bounds[band + 1], parent); });
+        for(size_t band = 1; band < bandCount; ++band) {
+            const size_t mid = bounds[band];
+            if(mid == 0 || mid == sorted.size() || sorted[mid - 1].first + 1 != sorted[mid].first)
+                continue;
+            uniteRows(sorted, rowBeginOf(sorted, 0, mid - 1), mid,
+                      mid, rowEndOf(sorted, sorted.size(), mid), parent);
+        }
+    }
+
+    // 第二遍：按 rects 的顺序为每个根分配聚类编号
+    vector<int> clusterOf(sorted.size(), -1);
+    vector<vector<pair<int, int>>> clusters;
+    for(size_t i = 0; i < n; ++i) {
+        if(position[i] < 0) continue;
+        const int root = findRoot(parent, position[i]);
+        if(clusterOf[root] < 0) {
+            clusterOf[root] = static_cast<int>(clusters.size());
+            clusters.emplace_back();
+        }
+        clusters[clusterOf[root]].push_back(rects[i]);
+    }
+    return clusters;
+}
+
+vector<vector<pair<int, int>>> clusterSubmatrices(const vector<pair<int, int>>& rects, int /*x*/, int /*y*/) {
+    return clusterSubmatricesImpl(rects, 1);
+}
+
+vector<vector<pair<int, int>>> clusterSubmatricesParallel(const vector<pair<int, int>>& rects, int /*x*/, int /*y*/, unsigned threadCount) {
+    return clusterSubmatricesImpl(rects, resolveThreadCount(threadCount));
+}
+
+// 对每个聚类，计算其中有多少个不重叠的网格区域，并返回每类中的这些区域
+// 输入：clusters（每类的所有左上角坐标），x, y（子矩阵大小）
+// 输出：vector<vector<pair<int,int>>>，每个聚类中不重叠子矩阵的左上角坐标集合
+vector<vector<pair<int, int>>> getNonOverlappingInClusters(
+    const vector<vector<pair<int, int>>>& clusters,
+    int x, int y
+) {
+    vector<vector<pair<int, int>>> result;
+    for(const auto& cluster : clusters) {
+        // 先将所有子矩阵左上角按行优先、列次之排序，保证贪心选择顺序
+        vector<pair<int, int>> rects = cluster;
+        sort(rects.begin(), rects.end());
+        result.push_back(selectNonOverlapping(rects, x, y));
+    }
+    return result;
+}
+
+struct SubmatrixQuery::Impl {
+    size_t rows = 0, cols = 0;
+    // 两者只有一个被使用，按网格大小选择
+    bool wide = false;
+    Grid<uint32_t> narrowSum;
+    Grid<uint64_t> wideSum;
+};
+
+SubmatrixQuery::SubmatrixQuery(const Grid<int>& grid, unsigned threadCount) : impl_(new Impl) {
+    impl_->rows = grid.rows();
+    impl_->cols = grid.cols();
+    impl_->wide = !prefixSumFitsUint32(grid.rows(), grid.cols());
+    threadCount = resolveThreadCount(threadCount);
+    if(impl_->wide)
+        buildPrefixSumParallelImpl(grid, impl_->wideSum, threadCount);
+    else
+        buildPrefixSumParallelImpl(grid, impl_->narrowSum, threadCount);
+}
+
+SubmatrixQuery::~SubmatrixQuery() = default;
+SubmatrixQuery::SubmatrixQuery(SubmatrixQuery&& other) noexcept = default;
+SubmatrixQuery& SubmatrixQuery::operator=(SubmatrixQuery&& other) noexcept = default;
+
+size_t SubmatrixQuery::rows() const { return impl_->rows; }
+size_t SubmatrixQuery::cols() const { return impl_->cols; }
+
+template<typename Acc>
+static uint64_t windowSum(const Grid<Acc>& sum, int row, int col, int x, int y) {
+    const Acc* top = sum.row_data(static_cast<size_t>(row));
+    const Acc* bottom = sum.row_data(static_cast<size_t>(row + x));
+    return bottom[col + y] - top[col + y] - bottom[col] + top[col];
+}
+
+uint64_t SubmatrixQuery::countOnes(int row, int col, int x, int y) const {
+    if(impl_->wide)
+        return windowSum(impl_->wideSum, row, col, x, y);
+    return windowSum(impl_->narrowSum, row, col, x, y);
+}
+
+vector<pair<int, int>> SubmatrixQuery::find(int x, int y, bool checkOverlap) const {
+    if(impl_->wide)
+        return searchPrefixSum(impl_->wideSum, x, y, checkOverlap);
+    return searchPrefixSum(impl_->narrowSum, x, y, checkOverlap);
+}
+
+}  // namespace submatrix_search
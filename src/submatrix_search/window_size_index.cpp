@@ -0,0 +1,179 @@
+#include <cpp_sandbox/submatrix_search.hpp>
+#include <algorithm>
+
+namespace submatrix_search {
+
+struct WindowSizeIndex::Impl {
+    // down(i, j)：从 (i, j) 起向下连续 1 的个数
+    Grid<uint32_t> down;
+    // square(i, j)：以 (i, j) 为左上角的最大全 1 正方形边长
+    Grid<uint32_t> square;
+    // nextSmaller(i, j)：第 i 行 j 右侧第一个 down 小于 down(i, j) 的列，没有时为 n
+    Grid<uint32_t> nextSmaller;
+    // 每行 down 的最大值，查询时整行跳过
+    std::vector<uint32_t> rowMaxDown;
+};
+
+WindowSizeIndex::WindowSizeIndex(const Grid<int>& grid) : impl_(new Impl) {
+    const size_t m = grid.rows(), n = grid.cols();
+    impl_->down.reshape(m, n);
+    impl_->square.reshape(m, n);
+    impl_->nextSmaller.reshape(m, n);
+    impl_->rowMaxDown.assign(m, 0);
+
+    // 自下而上逐行递推，最后一行之下按全 0 处理
+    const std::vector<uint32_t> zeros(n + 1, 0);
+    for (size_t i = m; i-- > 0;) {
+        const int* cells = grid.row_data(i);
+        const uint32_t* downBelow = i + 1 < m ? impl_->down.row_data(i + 1) : zeros.data();
+        const uint32_t* squareBelow = i + 1 < m ? impl_->square.row_data(i + 1) : zeros.data();
+        uint32_t* down = impl_->down.row_data(i);
+        uint32_t* square = impl_->square.row_data(i);
+        uint32_t* nextSmaller = impl_->nextSmaller.row_data(i);
+
+        uint32_t rowMax = 0;
+        for (size_t j = 0; j < n; ++j) {
+            down[j] = cells[j] != 0 ? downBelow[j] + 1 : 0;
+            rowMax = std::max(rowMax, down[j]);
+        }
+        impl_->rowMaxDown[i] = rowMax;
+
+        // 正方形边长依赖右侧和右下方，行内从右向左
+        uint32_t right = 0, belowRight = 0;
+        for (size_t j = n; j-- > 0;) {
+            const uint32_t value = cells[j] != 0 ? std::min({squareBelow[j], right, belowRight}) + 1 : 0;
+            square[j] = value;
+            right = value;
+            belowRight = squareBelow[j];
+        }
+
+        // 不小于 down(i, j) 的列沿 nextSmaller 整段跳过，均摊 O(n)
+        for (size_t j = n; j-- > 0;) {
+            uint32_t next = static_cast<uint32_t>(j + 1);
+            while (next < n && down[next] >= down[j]) {
+                next = nextSmaller[next];
+            }
+            nextSmaller[j] = next;
+        }
+    }
+}
+
+WindowSizeIndex::~WindowSizeIndex() = default;
+WindowSizeIndex::WindowSizeIndex(WindowSizeIndex&& other) noexcept = default;
+WindowSizeIndex& WindowSizeIndex::operator=(WindowSizeIndex&& other) noexcept = default;
+
+size_t WindowSizeIndex::rows() const { return impl_->down.rows(); }
+size_t WindowSizeIndex::cols() const { return impl_->down.cols(); }
+
+int WindowSizeIndex::largestSquare(int row, int col) const {
+    return static_cast<int>(impl_->square(static_cast<size_t>(row), static_cast<size_t>(col)));
+}
+
+std::vector<std::pair<int, int>> WindowSizeIndex::maximalSizes(int row, int col) const {
+    std::vector<std::pair<int, int>> sizes;
+    const uint32_t* down = impl_->down.row_data(static_cast<size_t>(row));
+    const uint32_t* nextSmaller = impl_->nextSmaller.row_data(static_cast<size_t>(row));
+    const uint32_t n = static_cast<uint32_t>(cols());
+    // 向右扩展时高度取各列 down 的最小值，在下一个更矮的列之前宽度最大；每一步输出一项
+    for (uint32_t j = static_cast<uint32_t>(col); j < n && down[j] > 0; j = nextSmaller[j]) {
+        sizes.emplace_back(static_cast<int>(down[j]), static_cast<int>(nextSmaller[j]) - col);
+    }
+    return sizes;
+}
+
+std::vector<std::pair<int, int>> WindowSizeIndex::find(int x, int y) const {
+    std::vector<std::pair<int, int>> res;
+    if (x < 1 || y < 1) {
+        return res;
+    }
+    const uint32_t height = static_cast<uint32_t>(x);
+    const size_t width = static_cast<size_t>(y);
+    const size_t n = cols();
+    for (size_t i = 0; i < rows(); ++i) {
+        if (impl_->rowMaxDown[i] < height) {
+            continue;
+        }
+        const uint32_t* down = impl_->down.row_data(i);
+        // 从候选窗口的最右列向左检查，遇到 down < x 的列 k 时下一个候选起点为 k + 1，
+        // 一次跳过最多 y 个起点；[start, verified) 已确认满足条件，每列至多检查一次
+        size_t start = 0, verified = 0;
+        while (start + width <= n) {
+            size_t k = start + width;
+            while (k > verified && down[k - 1] >= height) {
+                --k;
+            }
+            if (k > verified) {
+                verified = start + width;
+                start = k;
+            } else {
+                res.emplace_back(static_cast<int>(i), static_cast<int>(start));
+                verified = start + width;
+                ++start;
+            }
+        }
+    }
+    return res;
+}
+
+Grid<uint64_t> WindowSizeIndex::countAllSizes(int maxX, int maxY) const {
+    const size_t maxHeight = static_cast<size_t>(std::max(maxX, 0));
+    const size_t maxWidth = static_cast<size_t>(std::max(maxY, 0));
+    const size_t n = cols();
+    Grid<uint64_t> counts(maxHeight + 1, maxWidth + 1, 0);
+    if (maxHeight == 0 || maxWidth == 0 || n == 0) {
+        return counts;
+    }
+
+    // runs(t, L) 为各行中 down >= t 的极大连续列段里长度为 L 的个数。
+    // 单调栈弹出高度为 H 的列时，得到的列段对 (low, H] 内的每个 t 都是极大的，
+    // 先在差分表上记 +1 / -1，最后沿 t 方向求后缀和
+    Grid<int64_t> diff(maxHeight + 1, n + 1, 0);
+    std::vector<uint32_t> heights(n);
+    std::vector<size_t> stack;
+    stack.reserve(n);
+    for (size_t i = 0; i < rows(); ++i) {
+        const uint32_t* down = impl_->down.row_data(i);
+        for (size_t j = 0; j < n; ++j) {
+            heights[j] = std::min<uint32_t>(down[j], static_cast<uint32_t>(maxHeight));
+        }
+        stack.clear();
+        for (size_t j = 0; j <= n; ++j) {
+            const uint32_t current = j < n ? heights[j] : 0;
+            while (!stack.empty() && heights[stack.back()] >= current) {
+                const uint32_t top = heights[stack.back()];
+                stack.pop_back();
+                const uint32_t low = std::max(stack.empty() ? 0u : heights[stack.back()], current);
+                if (low < top) {
+                    const size_t length = stack.empty() ? j : j - stack.back() - 1;
+                    diff(top, length) += 1;
+                    diff(low, length) -= 1;
+                }
+            }
+            if (j < n) {
+                stack.push_back(j);
+            }
+        }
+    }
+
+    // 长度为 L 的列段中能放下 y 列窗口的位置有 L - y + 1 个，
+    // 因此 counts(x, y) = sum_{L >= y} L * runs - (y - 1) * sum_{L >= y} runs
+    std::vector<int64_t> runs(n + 1, 0);
+    for (size_t t = maxHeight; t >= 1; --t) {
+        const int64_t* row = diff.row_data(t);
+        for (size_t length = 1; length <= n; ++length) {
+            runs[length] += row[length];
+        }
+        uint64_t runCount = 0, runLength = 0;
+        uint64_t* out = counts.row_data(t);
+        for (size_t length = n; length >= 1; --length) {
+            runCount += static_cast<uint64_t>(runs[length]);
+            runLength += static_cast<uint64_t>(runs[length]) * length;
+            if (length <= maxWidth) {
+                out[length] = runLength - (length - 1) * runCount;
+            }
+        }
+    }
+    return counts;
+}
+
+}  // namespace submatrix_search
@@ -0,0 +1,379 @@
+// 基于 string_converter 的文件转码工具
+// 用法：transcode -f <源编码> -t <目标编码> [-j 线程数] [-q] <输入文件> [输出文件]
+// 输入文件通过 mmap 映射，按安全字符边界分块后多线程转换，结果经对齐的大缓冲区按顺序写出；
+// 源编码与目标编码相同时直接用 sendfile 复制
+#include <cpp_sandbox/StringConverter.hpp>
+#include "mapped_file.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+namespace {
+
+enum class Encoding { UTF8, GB2312, UTF32, ANSI };
+
+// 每个线程一次处理的输入字节数，一轮共处理 线程数 × kChunkSize 字节，内存占用与文件大小无关
+constexpr size_t kChunkSize = 8 * 1024 * 1024;
+// 输出缓冲区大小和对齐
+constexpr size_t kOutputBufferSize = 4 * 1024 * 1024;
+constexpr size_t kOutputAlignment = 4096;
+
+void print_usage() {
+    std::fprintf(stderr,
+                 "Usage: transcode -f <from> -t <to> [-j threads] [-q] <input> [output]\n"
+                 "Encodings: utf8, gb2312 (code page 936), utf32 (native-endian wchar_t), ansi\n"
+                 "Output defaults to stdout. -j 0 uses all hardware threads (default).\n");
+}
+
+bool parse_encoding(std::string name, Encoding& encoding) {
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (name == "utf8" || name == "utf-8") {
+        encoding = Encoding::UTF8;
+    } else if (name == "gb2312" || name == "gbk" || name == "cp936") {
+        encoding = Encoding::GB2312;
+    } else if (name == "utf32" || name == "utf-32" || name == "wchar_t") {
+        encoding = Encoding::UTF32;
+    } else if (name == "ansi") {
+        encoding = Encoding::ANSI;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// 从 position 向后找到一个字符边界，previous 为之前已知的边界；position 超过输入末尾时返回 input.size()
+size_t find_boundary(Encoding encoding, std::string_view input, size_t position, size_t previous) {
+    if (position >= input.size()) {
+        return input.size();
+    }
+    switch (encoding) {
+    case Encoding::UTF8:
+        return StringConverter::utf8_chunk_boundary(input, position, previous);
+    case Encoding::GB2312:
+        return StringConverter::gb2312_chunk_boundary(input, position, previous);
+    case Encoding::UTF32:
+        return std::min(input.size(), (position + 3) / 4 * 4);
+    case Encoding::ANSI:
+        // 无法确定字符边界的 ANSI 编码（GB18030 的四字节序列含 0x30-0x39，ISO-2022 等有移位状态）不分块
+        return input.size();
+    }
+    return input.size();
+}
+
+// 按哪种编码的规则给源编码分块：ANSI 只有在实际使用的编码为 UTF-8 或 GBK 系列时才能安全分块，
+// 其它 ANSI 编码返回 Encoding::ANSI，整个输入作为一块转换
+Encoding boundary_encoding(Encoding from) {
+    if (from != Encoding::ANSI) {
+        return from;
+    }
+    std::string name;
+    for (const char c : StringConverter::get_ansi_encoding()) {
+        if (c != '-' && c != '_') {
+            name.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+        }
+    }
+    if (name == "UTF8") {
+        return Encoding::UTF8;
+    }
+    if (name == "GBK" || name == "CP936" || name == "MS936" || name == "WINDOWS936" || name == "GB2312" ||
+        name == "EUCCN") {
+        return Encoding::GB2312;
+    }
+    return Encoding::ANSI;
+}
+
+std::wstring_view as_wide(std::string_view bytes) {
+    return std::wstring_view(reinterpret_cast<const wchar_t*>(bytes.data()), bytes.size() / sizeof(wchar_t));
+}
+
+void append_wide(std::wstring_view wide, std::string& output) {
+    output.append(reinterpret_cast<const char*>(wide.data()), wide.size() * sizeof(wchar_t));
+}
+
+// 转换一块输入，结果追加到 output
+void convert_chunk(Encoding from, Encoding to, std::string_view input, std::string& output) {
+    static thread_local std::wstring wide;
+    wide.clear();
+    switch (from) {
+    case Encoding::UTF8:
+        switch (to) {
+        case Encoding::GB2312: StringConverter::append_utf8_to_gb2312(input, output); return;
+        case Encoding::ANSI: StringConverter::append_utf8_to_ansi(input, output); return;
+        case Encoding::UTF32: StringConverter::append_utf8_to_wstring(input, wide); append_wide(wide, output); return;
+        default: break;
+        }
+        break;
+    case Encoding::GB2312:
+        switch (to) {
+        case Encoding::UTF8: StringConverter::append_gb2312_to_utf8(input, output); return;
+        case Encoding::ANSI: StringConverter::append_gb2312_to_ansi(input, output); return;
+        case Encoding::UTF32: StringConverter::append_gb2312_to_wstring(input, wide); append_wide(wide, output); return;
+        default: break;
+        }
+        break;
+    case Encoding::ANSI:
+        switch (to) {
+        case Encoding::UTF8: StringConverter::append_ansi_to_utf8(input, output); return;
+        case Encoding::GB2312: StringConverter::append_ansi_to_gb2312(input, output); return;
+        case Encoding::UTF32: StringConverter::append_ansi_to_wstring(input, wide); append_wide(wide, output); return;
+        default: break;
+        }
+        break;
+    case Encoding::UTF32:
+        if (input.size() % sizeof(wchar_t) != 0) {
+            throw std::runtime_error("UTF-32 input length is not a multiple of 4 bytes");
+        }
+        switch (to) {
+        case Encoding::UTF8: StringConverter::append_wstring_to_utf8(as_wide(input), output); return;
+        case Encoding::GB2312: StringConverter::append_wstring_to_gb2312(as_wide(input), output); return;
+        case Encoding::ANSI: StringConverter::append_wstring_to_ansi(as_wide(input), output); return;
+        default: break;
+        }
+        break;
+    }
+    output.append(input);
+}
+
+void write_all(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        const ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(std::string("write failed: ") + std::strerror(errno));
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+// 按页对齐的输出缓冲区：小块输出先合并再写出，超过缓冲区大小的块直接写出
+class OutputWriter {
+public:
+    explicit OutputWriter(int fd) : fd_(fd) {
+        if (::posix_memalign(reinterpret_cast<void**>(&buffer_), kOutputAlignment, kOutputBufferSize) != 0) {
+            throw std::bad_alloc();
+        }
+    }
+
+    ~OutputWriter() { std::free(buffer_); }
+
+    OutputWriter(const OutputWriter&) = delete;
+    OutputWriter& operator=(const OutputWriter&) = delete;
+
+    void write(std::string_view data) {
+        total_ += data.size();
+        if (used_ + data.size() > kOutputBufferSize) {
+            flush();
+        }
+        if (data.size() >= kOutputBufferSize) {
+            write_all(fd_, data.data(), data.size());
+            return;
+        }
+        std::memcpy(buffer_ + used_, data.data(), data.size());
+        used_ += data.size();
+    }
+
+    void flush() {
+        write_all(fd_, buffer_, used_);
+        used_ = 0;
+    }
+
+    size_t total() const { return total_; }
+
+private:
+    int fd_;
+    char* buffer_ = nullptr;
+    size_t used_ = 0;
+    size_t total_ = 0;
+};
+
+// 源编码与目标编码相同时在内核中复制，无法 sendfile 时退回到从映射区写出
+size_t copy_identity(const MappedFile& input, int output_fd) {
+    const std::string_view bytes = input.bytes();
+    size_t copied = 0;
+#ifdef __linux__
+    off_t offset = 0;
+    while (copied < bytes.size()) {
+        const ssize_t sent = ::sendfile(output_fd, input.fd(), &offset, bytes.size() - copied);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (copied == 0 && (errno == EINVAL || errno == ENOSYS)) {
+                break;
+            }
+            throw std::runtime_error(std::string("sendfile failed: ") + std::strerror(errno));
+        }
+        if (sent == 0) {
+            break;
+        }
+        copied += static_cast<size_t>(sent);
+    }
+#endif
+    write_all(output_fd, bytes.data() + copied, bytes.size() - copied);
+    return bytes.size();
+}
+
+// 每轮把 线程数 × kChunkSize 字节的输入切成若干块并行转换，再按顺序写出
+size_t transcode(Encoding from, Encoding to, std::string_view input, unsigned int thread_count, int output_fd) {
+    const Encoding boundary = boundary_encoding(from);
+    OutputWriter writer(output_fd);
+    std::vector<std::string> pieces(thread_count);
+    std::vector<std::exception_ptr> errors(thread_count);
+    std::vector<size_t> bounds;
+
+    size_t position = 0;
+    while (position < input.size()) {
+        const size_t round_end = std::min(input.size(), position + kChunkSize * thread_count);
+        bounds.assign(1, position);
+        // 剩余输入不足 thread_count 块时只切出实际存在的块
+        for (unsigned int i = 1; i < thread_count && position + kChunkSize * i < round_end; ++i) {
+            const size_t split = find_boundary(boundary, input, position + kChunkSize * i, bounds.back());
+            if (split <= bounds.back() || split >= round_end) {
+                break;
+            }
+            bounds.push_back(split);
+        }
+        // 轮末也必须落在字符边界上
+        const size_t end = round_end == input.size() ? round_end : find_boundary(boundary, input, round_end, bounds.back());
+        bounds.push_back(end);
+
+        const size_t chunk_count = bounds.size() - 1;
+        auto work = [&](size_t i) {
+            pieces[i].clear();
+            errors[i] = nullptr;
+            try {
+                convert_chunk(from, to, input.substr(bounds[i], bounds[i + 1] - bounds[i]), pieces[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < chunk_count; ++i) {
+            workers.emplace_back(work, i);
+        }
+        work(0);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        for (size_t i = 0; i < chunk_count; ++i) {
+            if (errors[i]) {
+                try {
+                    std::rethrow_exception(errors[i]);
+                } catch (const std::exception& e) {
+                    throw std::runtime_error(std::string(e.what()) + " (in block starting at byte " +
+                                             std::to_string(bounds[i]) + ")");
+                }
+            }
+            writer.write(pieces[i]);
+        }
+        position = end;
+    }
+    writer.flush();
+    return writer.total();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Encoding from = Encoding::UTF8;
+    Encoding to = Encoding::UTF8;
+    bool has_from = false;
+    bool has_to = false;
+    bool quiet = false;
+    unsigned int thread_count = 0;
+
+    int option;
+    while ((option = ::getopt(argc, argv, "f:t:j:qh")) != -1) {
+        switch (option) {
+        case 'f':
+            has_from = parse_encoding(optarg, from);
+            if (!has_from) {
+                std::fprintf(stderr, "transcode: unknown encoding '%s'\n", optarg);
+                return 2;
+            }
+            break;
+        case 't':
+            has_to = parse_encoding(optarg, to);
+            if (!has_to) {
+                std::fprintf(stderr, "transcode: unknown encoding '%s'\n", optarg);
+                return 2;
+            }
+            break;
+        case 'j':
+            thread_count = static_cast<unsigned int>(std::strtoul(optarg, nullptr, 10));
+            break;
+        case 'q':
+            quiet = true;
+            break;
+        default:
+            print_usage();
+            return option == 'h' ? 0 : 2;
+        }
+    }
+    if (!has_from || !has_to || optind >= argc || argc - optind > 2) {
+        print_usage();
+        return 2;
+    }
+#if WCHAR_MAX <= 0xFFFF
+    if (from == Encoding::UTF32 || to == Encoding::UTF32) {
+        std::fprintf(stderr, "transcode: utf32 requires a 32-bit wchar_t\n");
+        return 2;
+    }
+#endif
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    try {
+        MappedFile input(argv[optind]);
+        int output_fd = STDOUT_FILENO;
+        if (argc - optind == 2 && std::strcmp(argv[optind + 1], "-") != 0) {
+            output_fd = ::open(argv[optind + 1], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (output_fd < 0) {
+                throw std::runtime_error(std::string("cannot open ") + argv[optind + 1] + ": " + std::strerror(errno));
+            }
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const size_t written = (from == to) ? copy_identity(input, output_fd)
+                                            : transcode(from, to, input.bytes(), thread_count, output_fd);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (output_fd != STDOUT_FILENO && ::close(output_fd) != 0) {
+            throw std::runtime_error(std::string("close failed: ") + std::strerror(errno));
+        }
+        if (!quiet) {
+            const double input_mb = static_cast<double>(input.bytes().size()) / (1024.0 * 1024.0);
+            std::fprintf(stderr, "transcode: %.1f MB -> %.1f MB in %.3f s (%.1f MB/s, %u threads)\n", input_mb,
+                         static_cast<double>(written) / (1024.0 * 1024.0), seconds,
+                         seconds > 0 ? input_mb / seconds : 0.0, thread_count);
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "transcode: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
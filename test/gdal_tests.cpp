@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cpp_sandbox/gdal_util_library.hpp>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+using namespace submatrix_search;
+
+// 在内存中创建单波段栅格，像元值逐行取自 values
+static GDALDatasetH createMemRaster(const std::vector<std::vector<double>>& values, GDALDataType type) {
+    GDALAllRegister();
+    const int rows = static_cast<int>(values.size());
+    const int cols = static_cast<int>(values.front().size());
+    GDALDatasetH dataset = GDALCreate(GDALGetDriverByName("MEM"), "", cols, rows, 1, type, nullptr);
+    REQUIRE(dataset != nullptr);
+    GDALRasterBandH band = GDALGetRasterBand(dataset, 1);
+    for (int row = 0; row < rows; ++row) {
+        std::vector<double> line = values[static_cast<size_t>(row)];
+        REQUIRE(GDALRasterIO(band, GF_Write, 0, row, cols, 1, line.data(), cols, 1, GDT_Float64, 0, 0) == CE_None);
+    }
+    return dataset;
+}
+
+static std::vector<std::pair<int, int>> searchBand(GDALRasterBandH band, int x, int y, bool checkOverlap) {
+    std::vector<std::pair<int, int>> found;
+    searchRasterBand(band, x, y, [&](int row, const std::vector<int>& cols) {
+        for (int col : cols) {
+            found.emplace_back(row, col);
+        }
+    }, checkOverlap);
+    return found;
+}
+
+TEST_CASE("searchRasterBand", "[gdal_util_library]") {
+    SECTION("nodata fill is treated as 0") {
+        const double fill = -9999;
+        GDALDatasetH dataset = createMemRaster({
+            {3, 3, 3, fill, 7},
+            {3, fill, 3, 3, 7},
+            {3, 3, 3, 3, 7},
+            {fill, 3, 3, 3, 0},
+        }, GDT_Int16);
+        GDALRasterBandH band = GDALGetRasterBand(dataset, 1);
+        const Grid<int> withNoData = Grid<int>::from_rows({
+            {1, 1, 1, 0, 1},
+            {1, 0, 1, 1, 1},
+            {1, 1, 1, 1, 1},
+            {0, 1, 1, 1, 0},
+        });
+        const Grid<int> withoutNoData = Grid<int>::from_rows({
+            {1, 1, 1, 1, 1},
+            {1, 1, 1, 1, 1},
+            {1, 1, 1, 1, 1},
+            {1, 1, 1, 1, 0},
+        });
+
+        // 未设置 nodata 时 -9999 是普通的非 0 值
+        for (bool checkOverlap : {false, true}) {
+            REQUIRE(searchBand(band, 2, 2, checkOverlap) == findSubmatrices(withoutNoData, 2, 2, checkOverlap));
+        }
+        REQUIRE(GDALSetRasterNoDataValue(band, fill) == CE_None);
+        for (bool checkOverlap : {false, true}) {
+            for (int x = 1; x <= 4; ++x) {
+                for (int y = 1; y <= 5; ++y) {
+                    REQUIRE(searchBand(band, x, y, checkOverlap) == findSubmatrices(withNoData, x, y, checkOverlap));
+                }
+            }
+        }
+        REQUIRE(searchBand(band, 2, 2, false) == std::vector<std::pair<int, int>>{{1, 2}, {1, 3}, {2, 1}, {2, 2}});
+        GDALClose(dataset);
+    }
+
+    SECTION("fractional values and NaN nodata") {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        GDALDatasetH dataset = createMemRaster({
+            {0.25, 0.5, nan},
+            {0.75, -0.5, 1},
+            {nan, 0, 2},
+        }, GDT_Float32);
+        GDALRasterBandH band = GDALGetRasterBand(dataset, 1);
+        REQUIRE(GDALSetRasterNoDataValue(band, nan) == CE_None);
+        const Grid<int> expected = Grid<int>::from_rows({
+            {1, 1, 0},
+            {1, 1, 1},
+            {0, 0, 1},
+        });
+        for (int x = 1; x <= 3; ++x) {
+            for (int y = 1; y <= 3; ++y) {
+                REQUIRE(searchBand(band, x, y, false) == findSubmatrices(expected, x, y));
+            }
+        }
+        REQUIRE(searchBand(band, 2, 2, false) == std::vector<std::pair<int, int>>{{0, 0}});
+        GDALClose(dataset);
+    }
+}
@@ -1,10 +1,29 @@
 #include <catch2/catch_test_macros.hpp>
 #include <cpp_sandbox/sample_library0.hpp>
 #include <cpp_sandbox/sample_library1.hpp>
+#include <cpp_sandbox/ConversionCache.hpp>
+#include <cpp_sandbox/StreamingConverter.hpp>
 #include <cpp_sandbox/StringConverter.hpp>
+#include <cpp_sandbox/submatrix_search.hpp>
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <queue>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
+using namespace submatrix_search;
+
 TEST_CASE("Factorials are computed", "[factorial]") {
   REQUIRE(sample_library0::factorial(0) == 1);
   REQUIRE(sample_library0::factorial(1) == 1);
@@ -41,6 +60,25 @@ TEST_CASE("StringConverter", "[StringConverter]") {
         // "你好世界" 的 Unicode 码点
         std::wstring wide_chinese = L"\u4F60\u597D\u4E16\u754C";
         REQUIRE(StringConverter::utf8_to_wstring(utf8_chinese) == wide_chinese);
+
+        // 测试长字符串（覆盖 ASCII 快速路径与多字节字符交替的情况）
+        std::string utf8_long;
+        std::wstring wide_long;
+        for (int i = 0; i < 100; ++i) {
+            utf8_long += "abcdefghijklmnopqrstuvwxyz0123456789";
+            wide_long += L"abcdefghijklmnopqrstuvwxyz0123456789";
+            if (i % 7 == 0) {
+                utf8_long += utf8_chinese + "\xf0\x9f\x98\x80";
+                wide_long += wide_chinese + L"\U0001F600";
+            }
+        }
+        REQUIRE(StringConverter::utf8_to_wstring(utf8_long) == wide_long);
+
+        // 测试非法 UTF-8 序列
+        REQUIRE_THROWS_AS(StringConverter::utf8_to_wstring("abc\xff"), std::runtime_error);
+        REQUIRE_THROWS_AS(StringConverter::utf8_to_wstring("\xc0\xaf"), std::runtime_error);
+        REQUIRE_THROWS_AS(StringConverter::utf8_to_wstring("\xed\xa0\x80"), std::runtime_error);
+        REQUIRE_THROWS_AS(StringConverter::utf8_to_wstring("abc\xe4\xbd"), std::runtime_error);
     }
     
     SECTION("wstring_to_utf8") {
@@ -64,6 +102,23 @@ TEST_CASE("StringConverter", "[StringConverter]") {
         // "你好世界" 的 UTF-8 编码
         std::string utf8_chinese = "\xe4\xbd\xa0\xe5\xa5\xbd\xe4\xb8\x96\xe7\x95\x8c";
         REQUIRE(StringConverter::wstring_to_utf8(wide_chinese) == utf8_chinese);
+
+        // 测试长字符串往返
+        std::wstring wide_long;
+        for (int i = 0; i < 100; ++i) {
+            wide_long += L"abcdefghijklmnopqrstuvwxyz0123456789";
+            if (i % 5 == 0) {
+                wide_long += wide_chinese;
+            }
+        }
+        REQUIRE(StringConverter::utf8_to_wstring(StringConverter::wstring_to_utf8(wide_long)) == wide_long);
+
+#ifndef _WIN32
+        // 测试非法码点（代理项）
+        std::wstring wide_surrogate = L"abc";
+        wide_surrogate += static_cast<wchar_t>(0xD800);
+        REQUIRE_THROWS_AS(StringConverter::wstring_to_utf8(wide_surrogate), std::runtime_error);
+#endif
     }
     
     SECTION("ansi_to_wstring") {
@@ -163,6 +218,16 @@ TEST_CASE("StringConverter", "[StringConverter]") {
         // "你好世界" 的 Unicode 码点
         std::wstring wide_chinese = L"\u4F60\u597D\u4E16\u754C";
         REQUIRE(StringConverter::gb2312_to_wstring(gb2312_chinese) == wide_chinese);
+
+        // 测试与代码页 936 一致的映射：欧元符号、GBK 扩展字符、中点
+        REQUIRE(StringConverter::gb2312_to_wstring("\x80") == L"\u20AC");
+        REQUIRE(StringConverter::gb2312_to_wstring("\x81\x40") == L"\u4E02");
+        REQUIRE(StringConverter::gb2312_to_wstring("\xA1\xA4") == L"\u00B7");
+
+        // 测试非法与不完整的序列
+        REQUIRE_THROWS_AS(StringConverter::gb2312_to_wstring("abc\xFF"), std::runtime_error);
+        REQUIRE_THROWS_AS(StringConverter::gb2312_to_wstring("\x81\x7F"), std::runtime_error);
+        REQUIRE_THROWS_AS(StringConverter::gb2312_to_wstring("abc\xC4"), std::runtime_error);
     }
     
     SECTION("wstring_to_gb2312") {
@@ -232,6 +297,13 @@ TEST_CASE("StringConverter", "[StringConverter]") {
         // "你好世界" 的 GB2312 编码
         std::string gb2312_chinese = "\xC4\xE3\xBA\xC3\xCA\xC0\xBD\xE7";
         REQUIRE(StringConverter::utf8_to_gb2312(utf8_chinese) == gb2312_chinese);
+
+        // 测试欧元符号与 GBK 扩展字符的往返
+        std::string gbk_extended = "\x80\x81\x40 GIS \xFE\x4F";
+        REQUIRE(StringConverter::utf8_to_gb2312(StringConverter::gb2312_to_utf8(gbk_extended)) == gbk_extended);
+
+        // 测试无法用 GB2312 表示的字符（emoji）
+        REQUIRE_THROWS_AS(StringConverter::utf8_to_gb2312("\xf0\x9f\x98\x80"), std::runtime_error);
     }
     
     SECTION("gb2312_to_ansi") {
@@ -268,6 +340,268 @@ TEST_CASE("StringConverter", "[StringConverter]") {
 #endif
     }
     
+    SECTION("output buffer overloads") {
+        std::string gb2312_chinese = "\xC4\xE3\xBA\xC3\xCA\xC0\xBD\xE7";
+        std::string utf8_chinese = "\xe4\xbd\xa0\xe5\xa5\xbd\xe4\xb8\x96\xe7\x95\x8c";
+
+        // 写入已有缓冲区：原有内容被替换
+        std::string output = "previous content";
+        StringConverter::gb2312_to_utf8(gb2312_chinese, output);
+        REQUIRE(output == utf8_chinese);
+
+        // 追加到缓冲区末尾
+        StringConverter::append_utf8_to_gb2312("|", output);
+        StringConverter::append_utf8_to_gb2312(utf8_chinese, output);
+        REQUIRE(output == utf8_chinese + "|" + gb2312_chinese);
+
+        std::wstring wide_output = L"id=";
+        StringConverter::append_gb2312_to_wstring(gb2312_chinese, wide_output);
+        REQUIRE(wide_output == L"id=\u4F60\u597D\u4E16\u754C");
+
+        // 转换失败时追加缓冲区恢复原状
+        std::string record = "name=";
+        REQUIRE_THROWS_AS(StringConverter::append_utf8_to_gb2312("ok\xff", record), std::runtime_error);
+        REQUIRE(record == "name=");
+    }
+
+    SECTION("parallel conversion") {
+        // 约 1.5 MiB 的中英文混合输入，分块边界会落在多字节字符中间
+        std::string gb2312_large;
+        std::string utf8_large;
+        for (int i = 0; i < 50000; ++i) {
+            gb2312_large += "\xC4\xE3\xBA\xC3\xCA\xC0\xBD\xE7\x81\x40 GIS-";
+            utf8_large += "\xe4\xbd\xa0\xe5\xa5\xbd\xe4\xb8\x96\xe7\x95\x8c\xe4\xb8\x82 GIS-";
+        }
+        // 纯双字节段落，只能靠奇偶对齐确定边界
+        for (int i = 0; i < 200000; ++i) {
+            gb2312_large += "\xD6\xD0";
+            utf8_large += "\xe4\xb8\xad";
+        }
+
+        for (unsigned int threads : {1u, 3u, 4u}) {
+            REQUIRE(StringConverter::parallel_gb2312_to_utf8(gb2312_large, threads) == utf8_large);
+            REQUIRE(StringConverter::parallel_utf8_to_wstring(utf8_large, threads) ==
+                    StringConverter::utf8_to_wstring(utf8_large));
+        }
+        REQUIRE(StringConverter::parallel_gb2312_to_utf8("") == "");
+
+        // 错误与串行版本一致
+        std::string broken = utf8_large;
+        broken[broken.size() / 3] = '\xff';
+        REQUIRE_THROWS_AS(StringConverter::parallel_utf8_to_wstring(broken, 4), std::runtime_error);
+        std::string broken_gb2312 = gb2312_large;
+        broken_gb2312[broken_gb2312.size() - 101] = '\x20';
+        REQUIRE_THROWS_AS(StringConverter::parallel_gb2312_to_utf8(broken_gb2312, 4), std::runtime_error);
+
+        // 混合 ASCII、欧元符号（GBK 单字节 0x80）和四字节 UTF-8 序列，各块输出长度各不相同
+        std::string gb2312_mixed, utf8_mixed;
+        for (int i = 0; i < 60000; ++i) {
+            gb2312_mixed += "GIS \x80\xC4\xE3\n";
+            utf8_mixed += "GIS \xe2\x82\xac\xf0\x9f\x8c\x8f\xe4\xbd\xa0\n";
+        }
+        const std::wstring wide_mixed = StringConverter::utf8_to_wstring(utf8_mixed);
+        for (unsigned int threads : {2u, 5u, 16u}) {
+            REQUIRE(StringConverter::parallel_gb2312_to_utf8(gb2312_mixed, threads) ==
+                    StringConverter::gb2312_to_utf8(gb2312_mixed));
+            REQUIRE(StringConverter::parallel_utf8_to_wstring(utf8_mixed, threads) == wide_mixed);
+        }
+
+        // 多个线程同时调用时共用一个线程池，池忙时调用方自己串行转换
+        std::vector<std::thread> callers;
+        std::vector<char> matched(4, 0);
+        for (size_t k = 0; k < matched.size(); ++k) {
+            callers.emplace_back([&, k] {
+                bool ok = true;
+                for (int round = 0; round < 5; ++round) {
+                    ok = ok && StringConverter::parallel_gb2312_to_utf8(gb2312_large, 4) == utf8_large;
+                    ok = ok && StringConverter::parallel_utf8_to_wstring(utf8_mixed, 4) == wide_mixed;
+                }
+                matched[k] = ok;
+            });
+        }
+        for (std::thread& caller : callers) {
+            caller.join();
+        }
+        REQUIRE(std::count(matched.begin(), matched.end(), 1) == static_cast<long>(matched.size()));
+    }
+
+    SECTION("chunk boundaries") {
+        // "你好GIS"：边界不能落在双字节字符中间
+        const std::string gb2312 = "\xC4\xE3\xBA\xC3GIS";
+        REQUIRE(StringConverter::gb2312_chunk_boundary(gb2312, 0) == 0);
+        REQUIRE(StringConverter::gb2312_chunk_boundary(gb2312, 1) == 2);
+        REQUIRE(StringConverter::gb2312_chunk_boundary(gb2312, 3, 2) == 4);
+        REQUIRE(StringConverter::gb2312_chunk_boundary(gb2312, 5) == 5);
+
+        const std::string utf8 = "\xe4\xbd\xa0GIS";
+        REQUIRE(StringConverter::utf8_chunk_boundary(utf8, 1) == 3);
+        REQUIRE(StringConverter::utf8_chunk_boundary(utf8, 4) == 4);
+
+        // 超过输入末尾的位置（线程数多于剩余块数时）直接返回输入长度，不越界读取
+        for (size_t position : {gb2312.size(), gb2312.size() + 1, gb2312.size() + (size_t(8) << 20)}) {
+            REQUIRE(StringConverter::gb2312_chunk_boundary(gb2312, position, 2) == gb2312.size());
+            REQUIRE(StringConverter::utf8_chunk_boundary(utf8, position) == utf8.size());
+        }
+        REQUIRE(StringConverter::gb2312_chunk_boundary("", 1) == 0);
+    }
+
+    SECTION("batch conversion") {
+        std::vector<std::string> gb2312_column = {"\xC4\xE3\xBA\xC3", "", "GIS", "\xCA\xC0\xBD\xE7\x81\x40"};
+        StringBatch utf8_batch = StringConverter::batch_gb2312_to_utf8(gb2312_column);
+        REQUIRE(utf8_batch.size() == 4);
+        REQUIRE(utf8_batch.offsets == std::vector<size_t>{0, 6, 6, 9, 18});
+        REQUIRE(utf8_batch[0] == "\xe4\xbd\xa0\xe5\xa5\xbd");
+        REQUIRE(utf8_batch[1].empty());
+        REQUIRE(utf8_batch[3] == "\xe4\xb8\x96\xe7\x95\x8c\xe4\xb8\x82");
+
+        std::vector<std::string_view> utf8_views(utf8_batch.offsets.size() - 1);
+        for (size_t i = 0; i < utf8_views.size(); ++i) {
+            utf8_views[i] = utf8_batch[i];
+        }
+        WStringBatch wide_batch = StringConverter::batch_utf8_to_wstring(utf8_views);
+        REQUIRE(wide_batch[0] == L"\u4F60\u597D");
+        REQUIRE(wide_batch[2] == L"GIS");
+        REQUIRE(StringConverter::batch_utf8_to_gb2312(utf8_views).data == gb2312_column[0] + "GIS" + gb2312_column[3]);
+        REQUIRE(StringConverter::batch_gb2312_to_utf8(std::vector<std::string>{}).empty());
+
+        // 大批量多线程转换的结果与串行一致
+        std::vector<std::string> large_column;
+        for (int i = 0; i < 60000; ++i) {
+            large_column.push_back(std::string(i % 7, 'a') + gb2312_column[i % 4] + std::to_string(i));
+        }
+        StringBatch serial = StringConverter::batch_gb2312_to_utf8(large_column);
+        StringBatch parallel = StringConverter::batch_gb2312_to_utf8(large_column, 4);
+        REQUIRE(parallel.data == serial.data);
+        REQUIRE(parallel.offsets == serial.offsets);
+        REQUIRE(parallel[12345] == StringConverter::gb2312_to_utf8(large_column[12345]));
+
+        // 错误信息包含出错元素的下标
+        large_column[40000] = "\xff";
+        try {
+            StringConverter::batch_gb2312_to_utf8(large_column, 4);
+            FAIL("expected an exception");
+        } catch (const std::runtime_error& e) {
+            REQUIRE(std::string(e.what()).find("element 40000") != std::string::npos);
+        }
+    }
+
+#ifndef _WIN32
+    SECTION("set_ansi_encoding") {
+        std::string utf8_chinese = "\xe4\xbd\xa0\xe5\xa5\xbd";
+        std::string gbk_chinese = "\xC4\xE3\xBA\xC3";
+
+        StringConverter::set_ansi_encoding("GB18030");
+        REQUIRE(StringConverter::utf8_to_ansi(utf8_chinese) == gbk_chinese);
+        REQUIRE(StringConverter::ansi_to_wstring(gbk_chinese) == L"\u4F60\u597D");
+
+        REQUIRE_THROWS_AS(StringConverter::set_ansi_encoding("NO-SUCH-ENCODING"), std::runtime_error);
+        REQUIRE(StringConverter::ansi_to_utf8(gbk_chinese) == utf8_chinese);
+
+        // 同一线程上切换编码后，已缓存的描述符按新编码重新打开；ANSI 为 UTF-8 时直接复制
+        StringConverter::set_ansi_encoding("UTF-8");
+        REQUIRE(StringConverter::utf8_to_ansi(utf8_chinese) == utf8_chinese);
+        REQUIRE(StringConverter::ansi_to_wstring(utf8_chinese) == L"\u4F60\u597D");
+        StringConverter::set_ansi_encoding("GB18030");
+        REQUIRE(StringConverter::utf8_to_ansi(utf8_chinese) == gbk_chinese);
+
+        // 恢复为检测到的系统编码
+        StringConverter::set_ansi_encoding("");
+        REQUIRE(StringConverter::ansi_to_utf8(StringConverter::utf8_to_ansi("Hello")) == "Hello");
+    }
+#endif
+
+    SECTION("validation and detection") {
+        std::string utf8_chinese = "GIS \xe4\xbd\xa0\xe5\xa5\xbd\xe4\xb8\x96\xe7\x95\x8c";
+        std::string gb2312_chinese = "GIS \xC4\xE3\xBA\xC3\xCA\xC0\xBD\xE7";
+
+        REQUIRE(StringConverter::is_ascii(""));
+        REQUIRE(StringConverter::is_ascii(std::string(100, 'a')));
+        REQUIRE_FALSE(StringConverter::is_ascii(std::string(100, 'a') + "\x80"));
+
+        REQUIRE(StringConverter::is_valid_utf8(utf8_chinese));
+        REQUIRE_FALSE(StringConverter::is_valid_utf8(gb2312_chinese));
+        REQUIRE_FALSE(StringConverter::is_valid_utf8("\xc0\xaf"));          // 过长编码
+        REQUIRE_FALSE(StringConverter::is_valid_utf8("\xed\xa0\x80"));      // 代理项
+        REQUIRE_FALSE(StringConverter::is_valid_utf8("\xf4\x90\x80\x80"));  // 超过 U+10FFFF
+        REQUIRE_FALSE(StringConverter::is_valid_utf8(utf8_chinese.substr(0, utf8_chinese.size() - 1)));
+
+        // 跨越 SIMD 块边界的长输入
+        std::string long_utf8;
+        for (int i = 0; i < 100; ++i) {
+            long_utf8 += utf8_chinese;
+        }
+        REQUIRE(StringConverter::is_valid_utf8(long_utf8));
+        long_utf8[long_utf8.size() / 2] = '\xff';
+        REQUIRE_FALSE(StringConverter::is_valid_utf8(long_utf8));
+
+        REQUIRE(StringConverter::is_valid_gb2312(gb2312_chinese));
+        REQUIRE_FALSE(StringConverter::is_valid_gb2312("\xC4"));
+
+        using Detected = StringConverter::DetectedEncoding;
+        REQUIRE(StringConverter::detect_encoding("Hello") == Detected::ASCII);
+        REQUIRE(StringConverter::detect_encoding(utf8_chinese) == Detected::UTF8);
+        REQUIRE(StringConverter::detect_encoding(gb2312_chinese) == Detected::GB2312);
+        REQUIRE(StringConverter::detect_encoding("\xff\xfe") == Detected::Unknown);
+    }
+
+    SECTION("noexcept conversions") {
+        std::string output = "previous";
+        REQUIRE_FALSE(StringConverter::try_gb2312_to_utf8("\xC4\xE3\xBA\xC3", output));
+        REQUIRE(output == "\xe4\xbd\xa0\xe5\xa5\xbd");
+
+        REQUIRE(StringConverter::try_utf8_to_gb2312("ok\xff", output) == std::errc::illegal_byte_sequence);
+        REQUIRE(output.empty());
+        REQUIRE(StringConverter::try_gb2312_to_utf8("ok\xC4", output) == std::errc::invalid_argument);
+
+        std::wstring wide;
+        REQUIRE_FALSE(StringConverter::try_utf8_to_wstring("\xe4\xbd\xa0", wide));
+        REQUIRE(wide == L"\u4F60");
+        REQUIRE_FALSE(StringConverter::try_wstring_to_utf8(wide, output));
+        REQUIRE(output == "\xe4\xbd\xa0");
+        REQUIRE_FALSE(StringConverter::try_gb2312_to_wstring("\xC4\xE3", wide));
+        REQUIRE_FALSE(StringConverter::try_wstring_to_gb2312(wide, output));
+        REQUIRE(output == "\xC4\xE3");
+        REQUIRE(StringConverter::try_utf8_to_wstring("\xe4\xbd", wide));
+    }
+
+    SECTION("string_view inputs") {
+        // 直接转换大缓冲区中的片段，无需先复制为 std::string
+        std::string buffer = "key=\xe4\xbd\xa0\xe5\xa5\xbd;rest";
+        std::string_view field(buffer.data() + 4, 6);
+        REQUIRE(StringConverter::utf8_to_wstring(field) == L"\u4F60\u597D");
+        REQUIRE(StringConverter::utf8_to_gb2312(field) == "\xC4\xE3\xBA\xC3");
+
+        std::wstring wide = L"\u4F60\u597D\u4E16\u754C";
+        REQUIRE(StringConverter::wstring_to_utf8(std::wstring_view(wide).substr(2)) == "\xe4\xb8\x96\xe7\x95\x8c");
+    }
+
+    SECTION("compile-time encoding pairs") {
+        using Encoding = StringConverter::Encoding;
+        std::string gb2312 = "\xC4\xE3\xBA\xC3";
+        std::string utf8 = "\xe4\xbd\xa0\xe5\xa5\xbd";
+
+        REQUIRE(StringConverter::convert<Encoding::GB2312, Encoding::UTF8>(gb2312) == utf8);
+        REQUIRE(StringConverter::convert<Encoding::UTF8, Encoding::GB2312>(utf8) == gb2312);
+        REQUIRE(StringConverter::convert<Encoding::UTF8, Encoding::Wide>(utf8) == L"你好");
+        REQUIRE(StringConverter::convert<Encoding::Wide, Encoding::GB2312>(L"你好") == gb2312);
+        REQUIRE(StringConverter::convert<Encoding::UTF8, Encoding::UTF8>(utf8) == utf8);
+
+        // 与具名函数结果一致
+        REQUIRE(StringConverter::convert<Encoding::Wide, Encoding::ANSI>(L"Hello") ==
+                StringConverter::wstring_to_ansi(L"Hello"));
+
+        std::string output = "x";
+        StringConverter::convert<Encoding::GB2312, Encoding::UTF8>(gb2312, output);
+        REQUIRE(output == utf8);
+        StringConverter::append<Encoding::GB2312, Encoding::UTF8>(gb2312, output);
+        REQUIRE(output == utf8 + utf8);
+
+        // 转换失败时输出恢复为调用前的内容
+        REQUIRE_THROWS_AS((StringConverter::append<Encoding::UTF8, Encoding::GB2312>("\xff", output)),
+                          std::runtime_error);
+        REQUIRE(output == utf8 + utf8);
+    }
+
     SECTION("ansi_to_gb2312") {
         // 测试空字符串
         REQUIRE(StringConverter::ansi_to_gb2312("") == "");
@@ -302,3 +636,799 @@ TEST_CASE("StringConverter", "[StringConverter]") {
 #endif
     }
 }
+
+TEST_CASE("ConversionCache", "[ConversionCache]") {
+    const std::string gb2312_chinese = "\xC4\xE3\xBA\xC3\xCA\xC0\xBD\xE7";
+    const std::string utf8_chinese = "\xe4\xbd\xa0\xe5\xa5\xbd\xe4\xb8\x96\xe7\x95\x8c";
+
+    SECTION("hits return the shared result") {
+        ConversionCache cache;
+        ConversionCache::Result first = cache.gb2312_to_utf8(gb2312_chinese);
+        ConversionCache::Result second = cache.gb2312_to_utf8(std::string(gb2312_chinese));
+        REQUIRE(*first == utf8_chinese);
+        REQUIRE(first == second);
+
+        // 不同的编码对使用不同的缓存项
+        REQUIRE(*cache.utf8_to_gb2312(utf8_chinese) == gb2312_chinese);
+        REQUIRE(*cache.utf8_to_ansi("Hello") == "Hello");
+
+        ConversionCache::Stats stats = cache.stats();
+        REQUIRE(stats.hits == 1);
+        REQUIRE(stats.misses == 3);
+        REQUIRE(stats.entries == 3);
+        REQUIRE(stats.evictions == 0);
+
+        cache.clear();
+        REQUIRE(cache.stats().entries == 0);
+        REQUIRE(cache.stats().bytes == 0);
+        REQUIRE(*first == utf8_chinese);
+    }
+
+    SECTION("bounded by bytes") {
+        ConversionCache cache(4096, 2);
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE(*cache.gb2312_to_utf8(gb2312_chinese + std::to_string(i)) == utf8_chinese + std::to_string(i));
+        }
+        ConversionCache::Stats stats = cache.stats();
+        REQUIRE(stats.bytes <= 4096);
+        REQUIRE(stats.evictions == 1000 - stats.entries);
+
+        // 超过分片容量的结果直接返回，不进入缓存
+        const std::string large(4096, 'a');
+        REQUIRE(*cache.gb2312_to_utf8(large) == large);
+        REQUIRE(cache.stats().entries == stats.entries);
+    }
+
+    SECTION("errors are not cached") {
+        ConversionCache cache;
+        REQUIRE_THROWS_AS(cache.utf8_to_gb2312("bad\xff"), std::runtime_error);
+        REQUIRE(cache.stats().entries == 0);
+    }
+}
+
+// 随机 0/1 网格，每个单元以 onesPerMille / 1000 的概率为 1；固定种子使结果可复现
+static Grid<int> randomGrid(size_t rows, size_t cols, unsigned onesPerMille, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<unsigned> dist(0, 999);
+    Grid<int> grid(rows, cols);
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            grid(i, j) = dist(rng) < onesPerMille ? 1 : 0;
+        }
+    }
+    return grid;
+}
+
+// 两个网格的形状和每个单元都相同
+template<typename T>
+static bool sameCells(const Grid<T>& a, const Grid<T>& b) {
+    if (a.rows() != b.rows() || a.cols() != b.cols()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.rows(); ++i) {
+        if (!std::equal(a.row_data(i), a.row_data(i) + a.cols(), b.row_data(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 每行起始地址都按 Grid<T>::kAlignment 字节对齐，行跨度不小于列数
+template<typename T>
+static bool rowsAligned(const Grid<T>& grid) {
+    for (size_t i = 0; i < grid.rows(); ++i) {
+        if (reinterpret_cast<std::uintptr_t>(grid.row_data(i)) % Grid<T>::kAlignment != 0) {
+            return false;
+        }
+    }
+    return grid.stride() >= grid.cols();
+}
+
+TEST_CASE("Grid", "[submatrix_search]") {
+    SECTION("rows are 64-byte aligned") {
+        for (size_t cols : {size_t(1), size_t(7), size_t(16), size_t(17), size_t(100)}) {
+            REQUIRE(rowsAligned(Grid<uint8_t>(5, cols)));
+            REQUIRE(rowsAligned(Grid<int>(5, cols)));
+            REQUIRE(rowsAligned(Grid<uint64_t>(5, cols)));
+            REQUIRE(rowsAligned(Grid<double>(5, cols)));
+        }
+        REQUIRE(Grid<int>(2, 17).stride() == 32);
+        REQUIRE(Grid<uint8_t>(2, 65).stride() == 128);
+        REQUIRE(Grid<int>(3, 4, 9)(2, 3) == 9);
+
+        const Grid<int> empty;
+        REQUIRE(empty.empty());
+        REQUIRE(Grid<int>(0, 5).empty());
+        REQUIRE(Grid<int>(5, 0).empty());
+    }
+
+    SECTION("reshape and assign reuse capacity") {
+        Grid<int> grid(8, 40, 1);
+        const int* storage = grid.data();
+
+        // 缩小时复用原有内存，行跨度按新的列数计算
+        grid.reshape(3, 10);
+        REQUIRE(grid.rows() == 3);
+        REQUIRE(grid.cols() == 10);
+        REQUIRE(grid.stride() == 16);
+        REQUIRE(grid.data() == storage);
+        REQUIRE(rowsAligned(grid));
+
+        // 容量之内重新变大同样不重新分配
+        grid.assign(4, 70, 5);
+        REQUIRE(grid.data() == storage);
+        REQUIRE(grid.stride() == 80);
+        for (size_t i = 0; i < grid.rows(); ++i) {
+            REQUIRE(std::all_of(grid.row(i).begin(), grid.row(i).end(), [](int v) { return v == 5; }));
+        }
+
+        // 超过容量时重新分配
+        grid.assign(9, 40, 2);
+        REQUIRE(grid.rows() == 9);
+        REQUIRE(rowsAligned(grid));
+        REQUIRE(grid(8, 39) == 2);
+    }
+
+    SECTION("copy and move") {
+        Grid<int> grid = Grid<int>::from_rows({{1, 2, 3}, {4, 5, 6}});
+        REQUIRE(grid.rows() == 2);
+        REQUIRE(grid.cols() == 3);
+        REQUIRE(grid[1][2] == 6);
+        REQUIRE(grid.row(0).size() == 3);
+        REQUIRE(Grid<int>::from_rows({}).empty());
+
+        Grid<int> copy(grid);
+        REQUIRE(sameCells(copy, grid));
+        REQUIRE(copy.data() != grid.data());
+        REQUIRE(rowsAligned(copy));
+        copy(0, 0) = 10;
+        REQUIRE(grid(0, 0) == 1);
+
+        Grid<int> assigned(7, 7, 0);
+        assigned = grid;
+        REQUIRE(sameCells(assigned, grid));
+        const Grid<int>& self = assigned;
+        assigned = self;
+        REQUIRE(sameCells(assigned, grid));
+
+        const int* storage = grid.data();
+        Grid<int> moved(std::move(grid));
+        REQUIRE(moved.data() == storage);
+        REQUIRE(moved(1, 0) == 4);
+        REQUIRE(grid.empty());
+
+        Grid<int> target(2, 2, 0);
+        target = std::move(moved);
+        REQUIRE(target.data() == storage);
+        REQUIRE(target(1, 1) == 5);
+    }
+}
+
+TEST_CASE("SubmatrixQuery", "[submatrix_search]") {
+    const Grid<int> grid = Grid<int>::from_rows({
+        {1, 1, 1, 0, 1},
+        {1, 1, 1, 1, 1},
+        {1, 1, 1, 1, 1},
+        {0, 1, 1, 1, 1},
+    });
+    const SubmatrixQuery query(grid);
+    REQUIRE(query.rows() == 4);
+    REQUIRE(query.cols() == 5);
+
+    SECTION("window counts") {
+        REQUIRE(query.countOnes(0, 0, 4, 5) == 18);
+        REQUIRE(query.countOnes(0, 3, 1, 1) == 0);
+        REQUIRE(query.countOnes(1, 1, 3, 4) == 12);
+    }
+
+    SECTION("matches findSubmatrices for every window size") {
+        for (int x = 1; x <= 4; ++x) {
+            for (int y = 1; y <= 5; ++y) {
+                REQUIRE(query.find(x, y) == findSubmatrices(grid, x, y));
+                REQUIRE(query.find(x, y, true) == findSubmatrices(grid, x, y, true));
+            }
+        }
+        const std::vector<std::pair<int, int>> expected = {{0, 0}, {1, 1}, {1, 2}};
+        REQUIRE(query.find(3, 3) == expected);
+        REQUIRE(query.find(3, 3, true).size() == 1);
+    }
+
+    SECTION("multi-threaded build") {
+        const SubmatrixQuery parallel(grid, 0);
+        REQUIRE(parallel.find(2, 2) == query.find(2, 2));
+    }
+}
+
+TEST_CASE("Prefix sum width", "[submatrix_search]") {
+    SECTION("uint32_t is chosen up to rows * cols == UINT32_MAX") {
+        const size_t limit = UINT32_MAX;
+        // UINT32_MAX = 65535 * 65537
+        REQUIRE(prefixSumFitsUint32(65535, 65537));
+        REQUIRE(prefixSumFitsUint32(65537, 65535));
+        REQUIRE_FALSE(prefixSumFitsUint32(65536, 65537));
+        REQUIRE_FALSE(prefixSumFitsUint32(65536, 65536));
+        REQUIRE(prefixSumFitsUint32(1, limit));
+        REQUIRE(prefixSumFitsUint32(limit, 1));
+        REQUIRE_FALSE(prefixSumFitsUint32(1, limit + 1));
+        REQUIRE_FALSE(prefixSumFitsUint32(limit + 1, 1));
+        REQUIRE(prefixSumFitsUint32(2, limit / 2));
+        REQUIRE_FALSE(prefixSumFitsUint32(2, limit / 2 + 1));
+        REQUIRE(prefixSumFitsUint32(0, limit * 4));
+        REQUIRE(prefixSumFitsUint32(limit * 4, 0));
+    }
+
+    SECTION("uint64_t sums beyond 32 bits") {
+        // 单元值足够大，使前缀和超过 32 位，但每个单元仍在 int 范围内
+        const int big = 1 << 30;
+        Grid<int> grid(9, 13);
+        for (size_t i = 0; i < grid.rows(); ++i) {
+            for (size_t j = 0; j < grid.cols(); ++j) {
+                grid(i, j) = (i + j) % 3 == 0 ? 0 : big - static_cast<int>(i * 7 + j);
+            }
+        }
+        Grid<uint64_t> expected(grid.rows() + 1, grid.cols() + 1, 0);
+        for (size_t i = 1; i <= grid.rows(); ++i) {
+            for (size_t j = 1; j <= grid.cols(); ++j) {
+                expected(i, j) = expected(i - 1, j) + expected(i, j - 1) - expected(i - 1, j - 1) +
+                                 static_cast<uint64_t>(grid(i - 1, j - 1));
+            }
+        }
+        REQUIRE(expected(grid.rows(), grid.cols()) > UINT32_MAX);
+
+        Grid<uint64_t> sum;
+        buildPrefixSum(grid, sum);
+        REQUIRE(sameCells(sum, expected));
+        for (unsigned threads : {2u, 4u, 16u}) {
+            buildPrefixSumParallel(grid, sum, threads);
+            REQUIRE(sameCells(sum, expected));
+        }
+    }
+
+    SECTION("uint64_t search matches uint32_t search") {
+        const Grid<int> grid = randomGrid(40, 90, 900, 7);
+        Grid<uint32_t> sum32;
+        Grid<uint64_t> sum64;
+        for (bool checkOverlap : {false, true}) {
+            REQUIRE(findSubmatrices(grid, 3, 4, sum64, checkOverlap) == findSubmatrices(grid, 3, 4, sum32, checkOverlap));
+            REQUIRE(findSubmatrices(grid, 3, 4, sum64, checkOverlap) == findSubmatrices(grid, 3, 4, checkOverlap));
+        }
+    }
+}
+
+TEST_CASE("Parallel submatrix search", "[submatrix_search]") {
+    SECTION("prefix sums match the serial build") {
+        // 行数少于线程数（行带多于行）以及列数不是列块整数倍的情况
+        for (const auto& shape : std::vector<std::pair<size_t, size_t>>{{1, 1}, {3, 1000}, {7, 5}, {64, 300}, {257, 129}}) {
+            const Grid<int> grid = randomGrid(shape.first, shape.second, 700, static_cast<unsigned>(shape.first));
+            Grid<uint32_t> serial32, parallel32;
+            Grid<uint64_t> serial64, parallel64;
+            buildPrefixSum(grid, serial32);
+            buildPrefixSum(grid, serial64);
+            for (unsigned threads : {0u, 1u, 2u, 3u, 8u, 64u}) {
+                buildPrefixSumParallel(grid, parallel32, threads);
+                buildPrefixSumParallel(grid, parallel64, threads);
+                REQUIRE(sameCells(parallel32, serial32));
+                REQUIRE(sameCells(parallel64, serial64));
+            }
+        }
+    }
+
+    SECTION("results and order match findSubmatrices") {
+        unsigned seed = 100;
+        for (const auto& shape : std::vector<std::pair<size_t, size_t>>{{2, 9}, {5, 40}, {33, 70}, {200, 150}}) {
+            const Grid<int> grid = randomGrid(shape.first, shape.second, 850, seed++);
+            for (int x : {1, 2, 3, 6}) {
+                for (int y : {1, 2, 4, 9}) {
+                    for (bool checkOverlap : {false, true}) {
+                        const auto expected = findSubmatrices(grid, x, y, checkOverlap);
+                        // 线程数 × 4 个行带，小网格上行带多于候选行
+                        for (unsigned threads : {0u, 1u, 2u, 3u, 7u, 32u}) {
+                            REQUIRE(findSubmatricesParallel(grid, x, y, checkOverlap, threads) == expected);
+                        }
+                    }
+                }
+            }
+        }
+        REQUIRE(findSubmatricesParallel(Grid<int>(), 2, 2, false, 4).empty());
+        REQUIRE(findSubmatricesParallel(Grid<int>(3, 3, 1), 4, 1, true, 4).empty());
+    }
+}
+
+TEST_CASE("WindowSizeIndex", "[submatrix_search]") {
+    const Grid<int> grid = Grid<int>::from_rows({
+        {1, 1, 1, 0, 1},
+        {1, 1, 1, 1, 1},
+        {1, 1, 1, 1, 1},
+        {0, 1, 1, 1, 1},
+    });
+    const WindowSizeIndex index(grid);
+
+    SECTION("maximal sizes at a cell") {
+        REQUIRE(index.largestSquare(0, 0) == 3);
+        REQUIRE(index.largestSquare(1, 1) == 3);
+        REQUIRE(index.largestSquare(0, 3) == 0);
+        REQUIRE(index.maximalSizes(1, 0) == std::vector<std::pair<int, int>>{{2, 5}});
+        REQUIRE(index.maximalSizes(1, 1) == std::vector<std::pair<int, int>>{{3, 4}});
+        REQUIRE(index.maximalSizes(0, 0) == std::vector<std::pair<int, int>>{{3, 3}});
+        REQUIRE(index.maximalSizes(0, 3).empty());
+    }
+
+    SECTION("all window sizes match findSubmatrices") {
+        const Grid<uint64_t> counts = index.countAllSizes(5, 6);
+        for (int x = 1; x <= 5; ++x) {
+            for (int y = 1; y <= 6; ++y) {
+                const auto expected = findSubmatrices(grid, x, y);
+                REQUIRE(index.find(x, y) == expected);
+                REQUIRE(counts(x, y) == expected.size());
+            }
+        }
+    }
+
+    SECTION("random grids") {
+        for (unsigned density : {500u, 850u, 970u}) {
+            const Grid<int> random = randomGrid(30, 70, density, density);
+            const WindowSizeIndex randomIndex(random);
+            const Grid<uint64_t> counts = randomIndex.countAllSizes(12, 20);
+            for (int x = 1; x <= 12; ++x) {
+                for (int y = 1; y <= 20; ++y) {
+                    const auto expected = findSubmatrices(random, x, y);
+                    REQUIRE(randomIndex.find(x, y) == expected);
+                    REQUIRE(counts(x, y) == expected.size());
+                }
+            }
+            // 逐列向右扩展，高度下降前的宽度即该高度的最大宽度
+            for (int i = 0; i < 30; ++i) {
+                for (int j = 0; j < 70; ++j) {
+                    std::vector<std::pair<int, int>> expected;
+                    int height = 0;
+                    for (int k = j; k < 70; ++k) {
+                        int down = 0;
+                        while (i + down < 30 && random(static_cast<size_t>(i + down), static_cast<size_t>(k)) != 0) {
+                            ++down;
+                        }
+                        height = k == j ? down : std::min(height, down);
+                        if (height == 0) {
+                            break;
+                        }
+                        if (!expected.empty() && expected.back().first == height) {
+                            expected.back().second = k - j + 1;
+                        } else {
+                            expected.emplace_back(height, k - j + 1);
+                        }
+                    }
+                    REQUIRE(randomIndex.maximalSizes(i, j) == expected);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("WindowTracker", "[submatrix_search]") {
+    Grid<int> grid = Grid<int>::from_rows({
+        {1, 1, 1, 0, 1},
+        {1, 1, 1, 1, 1},
+        {1, 1, 1, 1, 1},
+        {0, 1, 1, 1, 1},
+    });
+
+    SECTION("FenwickGrid window sums") {
+        FenwickGrid fenwick(grid);
+        REQUIRE(fenwick.windowSum(0, 0, 4, 5) == 18);
+        REQUIRE(fenwick.windowSum(1, 1, 2, 3) == 6);
+        fenwick.set(1, 2, 0);
+        fenwick.add(0, 3, 5);
+        REQUIRE(fenwick.get(0, 3) == 5);
+        REQUIRE(fenwick.windowSum(0, 0, 4, 5) == 22);
+        REQUIRE(fenwick.windowSum(1, 1, 2, 3) == 5);
+        REQUIRE(fenwick.prefixSum(1, 4) == 8);
+    }
+
+    SECTION("batches of changes") {
+        WindowTracker tracker(grid, 2, 2);
+        REQUIRE(tracker.positions() == findSubmatrices(grid, 2, 2));
+
+        const std::vector<CellChange> changes = {{0, 3, 1}, {2, 2, 0}, {3, 0, 1}, {2, 2, 1}, {1, 1, 0}};
+        tracker.update(changes);
+        for (const CellChange& change : changes) {
+            grid(static_cast<size_t>(change.row), static_cast<size_t>(change.col)) = change.value;
+        }
+        REQUIRE(tracker.positions() == findSubmatrices(grid, 2, 2));
+        REQUIRE(tracker.isValid(0, 2));
+        REQUIRE_FALSE(tracker.isValid(0, 0));
+    }
+}
+
+TEST_CASE("StreamingSubmatrixSearch", "[submatrix_search]") {
+    const Grid<int> grid = Grid<int>::from_rows({
+        {1, 1, 1, 0, 1, 1},
+        {1, 1, 1, 1, 1, 1},
+        {1, 1, 1, 1, 1, 1},
+        {0, 1, 1, 1, 1, 1},
+        {1, 1, 1, 1, 0, 1},
+    });
+
+    for (bool checkOverlap : {false, true}) {
+        for (size_t strip : {size_t(1), size_t(2), size_t(5)}) {
+            std::vector<std::pair<int, int>> found;
+            StreamingSubmatrixSearch search(grid.cols(), 2, 3, [&](int row, const std::vector<int>& cols) {
+                for (int col : cols) {
+                    found.emplace_back(row, col);
+                }
+            }, checkOverlap);
+            for (size_t row = 0; row < grid.rows(); row += strip) {
+                search.pushRows(grid.row_data(row), std::min(strip, grid.rows() - row), grid.stride());
+            }
+            REQUIRE(search.rowsRead() == grid.rows());
+            REQUIRE(found == findSubmatrices(grid, 2, 3, checkOverlap));
+        }
+    }
+}
+
+#ifndef _WIN32
+TEST_CASE("searchRawMaskFile", "[submatrix_search]") {
+    // 每单元一个字节的掩膜文件，非 0 字节取不同的值
+    const Grid<int> grid = randomGrid(37, 150, 900, 600);
+    std::string bytes;
+    for (size_t i = 0; i < grid.rows(); ++i) {
+        for (size_t j = 0; j < grid.cols(); ++j) {
+            bytes.push_back(static_cast<char>(grid(i, j) != 0 ? 1 + (i * j) % 255 : 0));
+        }
+    }
+    const std::string path = (std::filesystem::temp_directory_path() / "cpp_sandbox_raw_mask.bin").string();
+    std::ofstream(path, std::ios::binary).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+    for (bool checkOverlap : {false, true}) {
+        for (size_t strip : {size_t(1), size_t(4), size_t(1024)}) {
+            std::vector<std::pair<int, int>> found;
+            searchRawMaskFile(path, grid.cols(), 3, 5, [&](int row, const std::vector<int>& cols) {
+                for (int col : cols) {
+                    found.emplace_back(row, col);
+                }
+            }, checkOverlap, strip);
+            REQUIRE(found == findSubmatrices(grid, 3, 5, checkOverlap));
+        }
+    }
+
+    const StreamingSubmatrixSearch::Sink ignore = [](int, const std::vector<int>&) {};
+    REQUIRE_THROWS_AS(searchRawMaskFile(path, grid.cols() - 1, 3, 5, ignore), std::runtime_error);
+    REQUIRE_THROWS_AS(searchRawMaskFile(path, 0, 3, 5, ignore), std::runtime_error);
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS(searchRawMaskFile(path, grid.cols(), 3, 5, ignore), std::runtime_error);
+}
+#endif
+
+// 朴素的贪心选取：按给定顺序逐个与已选中的全部子矩阵两两比较，O(k^2)
+static std::vector<std::pair<int, int>> bruteForceNonOverlapping(const std::vector<std::pair<int, int>>& rects, int x, int y) {
+    std::vector<std::pair<int, int>> selected;
+    for (const auto& p : rects) {
+        bool overlaps = false;
+        for (const auto& q : selected) {
+            if (std::abs(p.first - q.first) < x && std::abs(p.second - q.second) < y) {
+                overlaps = true;
+                break;
+            }
+        }
+        if (!overlaps) {
+            selected.push_back(p);
+        }
+    }
+    return selected;
+}
+
+TEST_CASE("Non-overlapping selection", "[submatrix_search]") {
+    SECTION("findSubmatrices with checkOverlap matches the pairwise greedy") {
+        unsigned seed = 200;
+        for (const auto& shape : std::vector<std::pair<size_t, size_t>>{{6, 6}, {30, 45}, {64, 130}}) {
+            for (unsigned density : {700u, 950u, 1000u}) {
+                const Grid<int> grid = randomGrid(shape.first, shape.second, density, seed++);
+                for (int x : {1, 2, 3, 5}) {
+                    for (int y : {1, 2, 4, 7, 65}) {
+                        const auto expected = bruteForceNonOverlapping(findSubmatrices(grid, x, y), x, y);
+                        REQUIRE(findSubmatrices(grid, x, y, true) == expected);
+                        REQUIRE(findSubmatricesParallel(grid, x, y, true, 3) == expected);
+                        REQUIRE(findSubmatrices(BitMask::from_grid(grid), x, y, true) == expected);
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("degenerate window sizes") {
+        const Grid<int> grid(3, 3, 1);
+        for (const auto& size : std::vector<std::pair<int, int>>{{2, 0}, {0, 2}, {0, 0}, {-1, 2}, {2, -3}}) {
+            for (bool checkOverlap : {false, true}) {
+                REQUIRE(findSubmatrices(grid, size.first, size.second, checkOverlap).empty());
+                REQUIRE(findSubmatricesParallel(grid, size.first, size.second, checkOverlap, 2).empty());
+                REQUIRE(SubmatrixQuery(grid).find(size.first, size.second, checkOverlap).empty());
+            }
+            // 面积为 0 的窗口互不重叠，与两两比较的结果相同
+            const std::vector<std::vector<std::pair<int, int>>> clusters = {{{0, 0}, {0, 1}, {1, 0}}};
+            REQUIRE(getNonOverlappingInClusters(clusters, size.first, size.second) == clusters);
+            REQUIRE(bruteForceNonOverlapping(clusters[0], size.first, size.second) == clusters[0]);
+        }
+    }
+
+    SECTION("getNonOverlappingInClusters matches the pairwise greedy") {
+        std::mt19937 rng(300);
+        for (int round = 0; round < 50; ++round) {
+            const int x = 1 + static_cast<int>(rng() % 4), y = 1 + static_cast<int>(rng() % 6);
+            // 任意顺序、可能重复、列范围不从 0 开始的坐标
+            std::vector<std::vector<std::pair<int, int>>> clusters(1 + rng() % 4);
+            for (auto& cluster : clusters) {
+                const int colOffset = static_cast<int>(rng() % 100);
+                const size_t count = rng() % 60;
+                for (size_t k = 0; k < count; ++k) {
+                    cluster.emplace_back(static_cast<int>(rng() % 20), colOffset + static_cast<int>(rng() % 25));
+                }
+            }
+            const auto result = getNonOverlappingInClusters(clusters, x, y);
+            REQUIRE(result.size() == clusters.size());
+            for (size_t c = 0; c < clusters.size(); ++c) {
+                std::vector<std::pair<int, int>> sorted = clusters[c];
+                std::sort(sorted.begin(), sorted.end());
+                REQUIRE(result[c] == bruteForceNonOverlapping(sorted, x, y));
+            }
+        }
+
+        const Grid<int> grid = randomGrid(40, 40, 900, 301);
+        const auto clusters = clusterSubmatrices(findSubmatrices(grid, 2, 3), 2, 3);
+        const auto result = getNonOverlappingInClusters(clusters, 2, 3);
+        for (size_t c = 0; c < clusters.size(); ++c) {
+            REQUIRE(result[c] == bruteForceNonOverlapping(clusters[c], 2, 3));
+        }
+    }
+}
+
+// 基准聚类：在坐标集合上做 BFS，聚类按首个坐标在 rects 中出现的顺序排列；
+// 类内坐标按其在 rects 中首次出现的顺序排列，与 clusterSubmatrices 的约定一致
+static std::vector<std::vector<std::pair<int, int>>> bfsClusters(const std::vector<std::pair<int, int>>& rects) {
+    const std::set<std::pair<int, int>> rectSet(rects.begin(), rects.end());
+    std::map<std::pair<int, int>, size_t> clusterOf;
+    size_t clusterCount = 0;
+    for (const auto& p : rects) {
+        if (clusterOf.count(p)) {
+            continue;
+        }
+        std::queue<std::pair<int, int>> queue;
+        queue.push(p);
+        clusterOf[p] = clusterCount;
+        while (!queue.empty()) {
+            const auto cur = queue.front();
+            queue.pop();
+            for (const auto& next : {std::make_pair(cur.first - 1, cur.second), std::make_pair(cur.first + 1, cur.second),
+                                     std::make_pair(cur.first, cur.second - 1), std::make_pair(cur.first, cur.second + 1)}) {
+                if (rectSet.count(next) && !clusterOf.count(next)) {
+                    clusterOf[next] = clusterCount;
+                    queue.push(next);
+                }
+            }
+        }
+        ++clusterCount;
+    }
+
+    std::vector<std::vector<std::pair<int, int>>> clusters(clusterCount);
+    std::set<std::pair<int, int>> seen;
+    for (const auto& p : rects) {
+        if (seen.insert(p).second) {
+            clusters[clusterOf[p]].push_back(p);
+        }
+    }
+    return clusters;
+}
+
+TEST_CASE("Clustering", "[submatrix_search]") {
+    auto check = [](const std::vector<std::pair<int, int>>& rects) {
+        const auto expected = bfsClusters(rects);
+        REQUIRE(clusterSubmatrices(rects, 2, 2) == expected);
+        // 线程数 × 行带：包括行带多于行、聚类跨越多个行带的情况
+        for (unsigned threads : {0u, 1u, 2u, 3u, 7u, 64u}) {
+            REQUIRE(clusterSubmatricesParallel(rects, 2, 2, threads) == expected);
+        }
+    };
+
+    SECTION("window positions from random grids") {
+        unsigned seed = 400;
+        for (const auto& shape : std::vector<std::pair<size_t, size_t>>{{3, 3}, {20, 30}, {120, 80}}) {
+            for (unsigned density : {500u, 800u, 950u}) {
+                const Grid<int> grid = randomGrid(shape.first, shape.second, density, seed++);
+                check(findSubmatrices(grid, 1, 1));
+                check(findSubmatrices(grid, 2, 3));
+            }
+        }
+        check({});
+    }
+
+    SECTION("unsorted input with duplicates") {
+        std::mt19937 rng(500);
+        for (int round = 0; round < 40; ++round) {
+            std::vector<std::pair<int, int>> rects;
+            const size_t count = rng() % 300;
+            for (size_t k = 0; k < count; ++k) {
+                rects.emplace_back(static_cast<int>(rng() % 25), static_cast<int>(rng() % 25) - 5);
+            }
+            // 部分坐标重复出现，整体打乱
+            for (size_t k = 0; k < count / 5; ++k) {
+                rects.push_back(rects[rng() % rects.size()]);
+            }
+            std::shuffle(rects.begin(), rects.end(), rng);
+            check(rects);
+        }
+    }
+
+    SECTION("clusters spanning band boundaries") {
+        // 一条贯穿所有行的竖线把每行的孤立点连起来，另有只在相邻行带交界处相连的蛇形路径
+        std::vector<std::pair<int, int>> rects;
+        for (int i = 0; i < 60; ++i) {
+            rects.emplace_back(i, 0);
+            if (i % 2 == 0) {
+                rects.emplace_back(i, 5);
+            }
+            const int col = 10 + (i / 2) % 2 * 3;
+            rects.emplace_back(i, col);
+            if (i % 2 == 1) {
+                for (int j = 11; j < 13; ++j) {
+                    rects.emplace_back(i, j);
+                }
+            }
+        }
+        check(rects);
+        std::reverse(rects.begin(), rects.end());
+        check(rects);
+    }
+}
+
+TEST_CASE("BitMask", "[submatrix_search]") {
+    SECTION("packing and ranges across word boundaries") {
+        const Grid<int> grid = randomGrid(3, 130, 500, 1);
+        const BitMask mask = BitMask::from_grid(grid);
+        REQUIRE(mask.rows() == 3);
+        REQUIRE(mask.cols() == 130);
+        REQUIRE(mask.words_per_row() >= 3);
+        size_t ones = 0;
+        for (size_t i = 0; i < grid.rows(); ++i) {
+            for (size_t j = 0; j < grid.cols(); ++j) {
+                REQUIRE(mask.get(i, j) == (grid(i, j) != 0));
+                ones += grid(i, j) != 0;
+            }
+        }
+        REQUIRE(mask.count() == ones);
+
+        std::vector<uint8_t> bytes(grid.rows() * grid.cols());
+        for (size_t i = 0; i < grid.rows(); ++i) {
+            for (size_t j = 0; j < grid.cols(); ++j) {
+                bytes[i * grid.cols() + j] = static_cast<uint8_t>(grid(i, j) * 255);
+            }
+        }
+        const BitMask fromBytes = BitMask::from_bytes(bytes.data(), grid.rows(), grid.cols(), grid.cols());
+        // 行起始地址按 64 字节对齐，相邻两行的字数可能大于 words_per_row()
+        const size_t wordStride = static_cast<size_t>(mask.row_data(1) - mask.row_data(0));
+        const BitMask fromWords = BitMask::from_words(mask.row_data(0), mask.rows(), mask.cols(), wordStride);
+        for (size_t i = 0; i < grid.rows(); ++i) {
+            for (size_t w = 0; w < mask.words_per_row(); ++w) {
+                REQUIRE(fromBytes.row_data(i)[w] == mask.row_data(i)[w]);
+                REQUIRE(fromWords.row_data(i)[w] == mask.row_data(i)[w]);
+            }
+        }
+
+        // 行末超出 cols() 的位保持为 0
+        BitMask range(2, 70);
+        range.set_range(0, 0, 70);
+        REQUIRE(range.count() == 70);
+        REQUIRE(range.row_data(0)[1] == (uint64_t(1) << 6) - 1);
+        range.clear_range(0, 60, 8);
+        REQUIRE(range.count() == 62);
+        REQUIRE_FALSE(range.any_in_range(0, 60, 8));
+        REQUIRE(range.any_in_range(0, 59, 2));
+        REQUIRE(range.any_in_range(0, 63, 6));
+        REQUIRE_FALSE(range.any_in_range(1, 0, 70));
+        range.set(1, 69);
+        REQUIRE(range.any_in_range(1, 0, 70));
+        REQUIRE(lowest_set_bit(range.row_data(1)[1]) == 5);
+    }
+
+    SECTION("allOnesWindows and findSubmatrices match the dense search") {
+        // 宽度取 64 的倍数附近，窗口包括超过一个字宽的列数
+        unsigned seed = 2;
+        for (size_t cols : {size_t(1), size_t(63), size_t(64), size_t(65), size_t(130), size_t(200)}) {
+            for (unsigned density : {600u, 995u}) {
+                const Grid<int> grid = randomGrid(17, cols, density, seed++);
+                const BitMask mask = BitMask::from_grid(grid);
+                for (int x : {1, 2, 5, 17}) {
+                    for (int y : {1, 3, 63, 64, 65, 100, 130}) {
+                        const auto expected = findSubmatrices(grid, x, y);
+                        const BitMask windows = allOnesWindows(mask, x, y);
+                        REQUIRE(windows.rows() == mask.rows());
+                        REQUIRE(windows.cols() == mask.cols());
+                        std::vector<std::pair<int, int>> positions;
+                        for (size_t i = 0; i < windows.rows(); ++i) {
+                            for (size_t j = 0; j < windows.cols(); ++j) {
+                                if (windows.get(i, j)) {
+                                    positions.emplace_back(static_cast<int>(i), static_cast<int>(j));
+                                }
+                            }
+                        }
+                        REQUIRE(positions == expected);
+                        REQUIRE(findSubmatrices(mask, x, y) == expected);
+                        REQUIRE(findSubmatrices(mask, x, y, true) == findSubmatrices(grid, x, y, true));
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("windows larger than the grid") {
+        const Grid<int> grid(4, 70, 1);
+        const BitMask mask = BitMask::from_grid(grid);
+        for (const auto& size : std::vector<std::pair<int, int>>{{5, 1}, {1, 71}, {5, 71}}) {
+            REQUIRE(allOnesWindows(mask, size.first, size.second).count() == 0);
+            REQUIRE(findSubmatrices(mask, size.first, size.second).empty());
+            REQUIRE(findSubmatrices(mask, size.first, size.second, true).empty());
+            REQUIRE(findSubmatrices(grid, size.first, size.second).empty());
+        }
+        REQUIRE(allOnesWindows(mask, 0, 3).count() == 0);
+        REQUIRE(findSubmatrices(mask, 3, 0).empty());
+        REQUIRE(findSubmatrices(mask, 4, 70) == std::vector<std::pair<int, int>>{{0, 0}});
+    }
+}
+
+#ifndef _WIN32
+TEST_CASE("StreamingConverter", "[StreamingConverter]") {
+    // "你好世界，GIS" 的 UTF-8 编码，包含多字节序列
+    const std::string utf8_text = "\xe4\xbd\xa0\xe5\xa5\xbd\xe4\xb8\x96\xe7\x95\x8c\xef\xbc\x8cGIS";
+    const std::string gb2312_text = StringConverter::utf8_to_gb2312(utf8_text);
+
+    std::string output;
+    const StreamingConverter::Sink sink = [&output](std::string_view data) { output.append(data); };
+
+    SECTION("chunks split inside multibyte sequences") {
+        auto converter = StreamingConverter::utf8_to_gb2312();
+        for (char byte : utf8_text) {
+            converter.write(std::string_view(&byte, 1), sink);
+        }
+        converter.finish(sink);
+        REQUIRE(output == gb2312_text);
+
+        // 转码器可以复用于下一个流
+        output.clear();
+        auto reverse = StreamingConverter::gb2312_to_utf8();
+        reverse.write(std::string_view(gb2312_text).substr(0, 3), sink);
+        REQUIRE(reverse.pending_bytes() == 1);
+        reverse.write(std::string_view(gb2312_text).substr(3), sink);
+        reverse.finish(sink);
+        REQUIRE(output == utf8_text);
+    }
+
+    SECTION("bounded output buffer") {
+        std::string large;
+        for (int i = 0; i < 1000; ++i) {
+            large += utf8_text;
+        }
+        StreamingConverter converter("UTF-8", "CP936", 16);
+        size_t max_piece = 0;
+        converter.write(large, [&](std::string_view data) {
+            max_piece = std::max(max_piece, data.size());
+            output.append(data);
+        });
+        converter.finish(sink);
+        REQUIRE(max_piece <= 16);
+        REQUIRE(output == StringConverter::utf8_to_gb2312(large));
+    }
+
+    SECTION("stream transcode") {
+        std::istringstream input(gb2312_text);
+        std::ostringstream result;
+        StreamingConverter::gb2312_to_utf8(4).transcode(input, result);
+        REQUIRE(result.str() == utf8_text);
+    }
+
+    SECTION("errors") {
+        auto converter = StreamingConverter::utf8_to_gb2312();
+        converter.write("ok\xe4\xbd", sink);
+        REQUIRE_THROWS_AS(converter.finish(sink), std::runtime_error);
+        REQUIRE(converter.pending_bytes() == 0);
+
+        REQUIRE_THROWS_AS(converter.write("bad\xff", sink), std::runtime_error);
+        REQUIRE_THROWS_AS(StreamingConverter("UTF-8", "NO-SUCH-ENCODING"), std::runtime_error);
+    }
+}
+#endif
@@ -0,0 +1,51 @@
+# transcode 回归测试：输入不足 线程数 × 8 MiB 时，多余的线程不能在输入末尾之后找分块边界；
+# ANSI 输入只在系统编码可以安全分块时分块，其它编码（如 GB18030）整体转换
+# 用法：cmake -DTRANSCODE=<transcode 路径> -DWORK_DIR=<临时目录> -P transcode_threads.cmake
+
+# 以 1、2、4、16 个线程转换 input，结果写入 ${name}_<线程数>.txt，并与单线程结果比较
+function(check_threads name lang from to input)
+  foreach(threads 1 2 4 16)
+    set(output "${WORK_DIR}/${name}_${threads}.txt")
+    execute_process(
+      COMMAND ${CMAKE_COMMAND} -E env LANG=${lang} LC_ALL= "${TRANSCODE}" -f ${from} -t ${to} -j ${threads} -q "${input}" "${output}"
+      RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+      message(FATAL_ERROR "${name}: transcode -j ${threads} failed: ${result}")
+    endif()
+    if(NOT threads EQUAL 1)
+      execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files "${WORK_DIR}/${name}_1.txt" "${output}"
+                      RESULT_VARIABLE result)
+      if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${name}: transcode -j ${threads} output differs from -j 1")
+      endif()
+    endif()
+  endforeach()
+endfunction()
+
+file(MAKE_DIRECTORY "${WORK_DIR}")
+
+# 约 17 MiB 的 GBK 文本："你好" + "GIS\n"，-j 4 时只有 3 块
+string(ASCII 196 227 186 195 gbk_word)
+string(REPEAT "${gbk_word}GIS\n" 2228224 gbk_text)
+file(WRITE "${WORK_DIR}/input.gbk" "${gbk_text}")
+check_threads(gbk C gbk utf8 "${WORK_DIR}/input.gbk")
+
+# ANSI 为 GBK 时按 GBK 规则分块，结果与 -f gbk 相同
+check_threads(ansi_gbk zh_CN.GBK ansi utf8 "${WORK_DIR}/input.gbk")
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files "${WORK_DIR}/gbk_1.txt" "${WORK_DIR}/ansi_gbk_1.txt"
+                RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "ansi (GBK) output differs from gbk output")
+endif()
+
+# ANSI 为 UTF-8 时按 UTF-8 规则分块
+check_threads(ansi_utf8 C.UTF-8 ansi utf32 "${WORK_DIR}/gbk_1.txt")
+
+# GB18030 的四字节序列（U+0080 为 81 30 81 30）含有小于 0x40 的字节，不能按字节值分块；
+# 每 12 字节重复一次，8 MiB 处正好落在四字节序列的首字节上
+string(ASCII 129 48 129 48 gb18030_word)
+string(REPEAT "${gbk_word}GIS\n${gb18030_word}" 1485483 gb18030_text)
+file(WRITE "${WORK_DIR}/input.gb18030" "${gb18030_text}")
+check_threads(ansi_gb18030 zh_CN.GB18030 ansi utf8 "${WORK_DIR}/input.gb18030")
+
+file(REMOVE_RECURSE "${WORK_DIR}")